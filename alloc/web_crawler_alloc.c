@@ -38,6 +38,8 @@ WebCrawlerApp *web_crawler_app_alloc()
 
     // Add Submenu items
     submenu_add_item(app->submenu_main, "Run", WebCrawlerSubmenuIndexRun, web_crawler_submenu_callback, app);
+    submenu_add_item(app->submenu_main, "Crawl List", WebCrawlerSubmenuIndexCrawl, web_crawler_submenu_callback, app);
+    submenu_add_item(app->submenu_main, "Crawl Site", WebCrawlerSubmenuIndexSite, web_crawler_submenu_callback, app);
     submenu_add_item(app->submenu_main, "About", WebCrawlerSubmenuIndexAbout, web_crawler_submenu_callback, app);
     submenu_add_item(app->submenu_main, "Settings", WebCrawlerSubmenuIndexConfig, web_crawler_submenu_callback, app);
 
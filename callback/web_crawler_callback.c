@@ -11,6 +11,7 @@
 #define FURI_LOG_DEV(tag, format, ...)
 #define DEV_CRASH()
 #endif
+#define LOADER_CONNECT_RETRY_MS 1000 // Wait between attempts to take a busy UART
 static uint32_t web_crawler_back_to_file_callback(void *context);
 static bool alloc_widget(WebCrawlerApp *app, uint32_t view)
 {
@@ -546,6 +547,18 @@ static void web_crawler_draw_error(Canvas *canvas, DataLoaderModel *model)
         return;
     }
 
+    if (model->fhttp->request_dropped > 0)
+    {
+        char dropped[32];
+        snprintf(dropped, sizeof(dropped), "%lu bytes were lost.", (unsigned long)model->fhttp->request_dropped);
+        canvas_draw_str(canvas, 0, 10, "[ERROR] Data was lost.");
+        canvas_draw_str(canvas, 0, 30, dropped);
+        canvas_draw_str(canvas, 0, 40, "The board sent faster than");
+        canvas_draw_str(canvas, 0, 50, "it could be saved.");
+        canvas_draw_str(canvas, 0, 60, "Press BACK to return.");
+        return;
+    }
+
     if (model->fhttp->last_response)
     {
         if (strstr(model->fhttp->last_response, "[ERROR] Not connected to Wifi. Failed to reconnect.") != NULL)
@@ -658,6 +671,72 @@ void web_crawler_http_method_change(VariableItem *item)
     save_simply();
 }
 
+// Function to send a request with the given HTTP method, saving the response to fhttp->file_path
+static bool web_crawler_send_request(DataLoaderModel *model, const char *http_method, const char *url, const char *headers, const char *payload)
+{
+    FlipperHTTP *fhttp = model->fhttp;
+
+    // Save the response to file
+    flipper_http_set_sink_file(fhttp);
+
+    if (strstr(http_method, "GET") != NULL)
+    {
+        fhttp->save_received_data = true;
+        fhttp->is_bytes_request = false;
+
+        // Ask only for changes if the last response of this URL is still saved
+        snprintf(model->cache_url, sizeof(model->cache_url), "%s", url);
+        char conditional_headers[256 + CACHE_HEADER_SIZE];
+        model->conditional = cache_if_modified_since(url, fhttp->file_path, headers, conditional_headers, sizeof(conditional_headers));
+        if (model->conditional)
+        {
+            headers = conditional_headers;
+        }
+
+        // Perform GET request and handle the response
+        if (strlen(headers) == 0)
+        {
+            return flipper_http_get_request(fhttp, url);
+        }
+        else
+        {
+            return flipper_http_get_request_with_headers(fhttp, url, headers);
+        }
+    }
+    else if (strstr(http_method, "POST") != NULL)
+    {
+        fhttp->save_received_data = true;
+        fhttp->is_bytes_request = false;
+
+        // Perform POST request and handle the response
+        return flipper_http_post_request_with_headers(fhttp, url, headers, payload);
+    }
+    else if (strstr(http_method, "PUT") != NULL)
+    {
+        fhttp->save_received_data = true;
+        fhttp->is_bytes_request = false;
+
+        // Perform PUT request and handle the response
+        return flipper_http_put_request_with_headers(fhttp, url, headers, payload);
+    }
+    else if (strstr(http_method, "DELETE") != NULL)
+    {
+        fhttp->save_received_data = true;
+        fhttp->is_bytes_request = false;
+
+        // Perform DELETE request and handle the response
+        return flipper_http_delete_request_with_headers(fhttp, url, headers, payload);
+    }
+    else // DOWNLOAD, or BROWSE without parsing
+    {
+        fhttp->save_received_data = false;
+        fhttp->is_bytes_request = true;
+
+        // Perform GET request and handle the response
+        return flipper_http_get_request_bytes(fhttp, url, "{\"Content-Type\": \"application/octet-stream\"}");
+    }
+}
+
 static bool web_crawler_fetch(DataLoaderModel *model)
 {
     WebCrawlerApp *app = (WebCrawlerApp *)model->parser_context;
@@ -717,67 +796,39 @@ static bool web_crawler_fetch(DataLoaderModel *model)
             STORAGE_EXT_PATH_PREFIX "/apps_data/web_crawler/received_data.txt");
     }
 
-    if (strstr(http_method, "GET") != NULL)
+    if (strstr(http_method, "BROWSE") == NULL)
     {
-        model->fhttp->save_received_data = true;
-        model->fhttp->is_bytes_request = false;
-
-        // Perform GET request and handle the response
-        if (strlen(headers) == 0)
-        {
-            return flipper_http_get_request(model->fhttp, url);
-        }
-        else
-        {
-            return flipper_http_get_request_with_headers(model->fhttp, url, headers);
-        }
+        return web_crawler_send_request(model, http_method, url, headers, payload);
     }
-    else if (strstr(http_method, "POST") != NULL)
-    {
-        model->fhttp->save_received_data = true;
-        model->fhttp->is_bytes_request = false;
 
-        // Perform POST request and handle the response
-        return flipper_http_post_request_with_headers(model->fhttp, url, headers, payload);
-    }
-    else if (strstr(http_method, "PUT") != NULL)
-    {
-        model->fhttp->save_received_data = true;
-        model->fhttp->is_bytes_request = false;
+    // BROWSE
+    model->fhttp->save_received_data = false;
+    model->fhttp->is_bytes_request = true;
 
-        // Perform PUT request and handle the response
-        return flipper_http_put_request_with_headers(model->fhttp, url, headers, payload);
-    }
-    else if (strstr(http_method, "DELETE") != NULL)
+    // parse the HTML while it downloads instead of saving it first
+    if (!app->html_stream)
     {
-        model->fhttp->save_received_data = true;
-        model->fhttp->is_bytes_request = false;
-
-        // Perform DELETE request and handle the response
-        return flipper_http_delete_request_with_headers(model->fhttp, url, headers, payload);
+        app->html_stream = html_furi_stream_alloc(MAX_FILE_SHOW);
     }
-    else if (strstr(http_method, "DOWNLOAD") != NULL)
+    if (app->html_stream)
     {
-        model->fhttp->save_received_data = false;
-        model->fhttp->is_bytes_request = true;
-
-        // Perform GET request and handle the response
-        return flipper_http_get_request_bytes(model->fhttp, url, "{\"Content-Type\": \"application/octet-stream\"}");
+        html_furi_stream_reset(app->html_stream);
+        html_furi_stream_set_link_callback(app->html_stream, NULL, NULL);
+        flipper_http_set_sink_parser(model->fhttp, html_furi_stream_feed, app->html_stream);
     }
-    else // BROWSE
+    else
     {
-        model->fhttp->save_received_data = false;
-        model->fhttp->is_bytes_request = true;
-
-        // download HTML response since the html could be large
-        return flipper_http_get_request_bytes(model->fhttp, url, "{\"Content-Type\": \"application/octet-stream\"}");
+        flipper_http_set_sink_file(model->fhttp);
     }
-    return false;
+
+    // download HTML response since the html could be large
+    return flipper_http_get_request_bytes(model->fhttp, url, "{\"Content-Type\": \"application/octet-stream\"}");
 }
 
 static char *web_crawler_parse(DataLoaderModel *model)
 {
-    UNUSED(model);
+    WebCrawlerApp *app = (WebCrawlerApp *)model->parser_context;
+    furi_check(app, "web_crawler_parse: WebCrawlerApp is NULL");
     // parse HTML response if BROWSE request
     char http_method[16];
     if (!load_char("http_method", http_method, 16))
@@ -786,74 +837,114 @@ static char *web_crawler_parse(DataLoaderModel *model)
     }
     else
     {
-        if (strstr(http_method, "BROWSE") != NULL)
+        if (strstr(http_method, "BROWSE") != NULL && app->html_stream)
+        {
+            // the page was parsed while it downloaded
+            flipper_http_set_sink_file(model->fhttp);
+            if (!app->html_stream->head_found)
+            {
+                FURI_LOG_E(TAG, "Invalid HTML response");
+                html_furi_stream_free(app->html_stream);
+                app->html_stream = NULL;
+                return strdup("Invalid HTML response.\n\n\n\n\nPress BACK to return.");
+            }
+            const char *text = html_furi_stream_get_text(app->html_stream);
+            char *response = NULL;
+            if (text[0] != '\0')
+            {
+                response = strdup(text);
+            }
+            html_furi_stream_free(app->html_stream);
+            app->html_stream = NULL;
+            if (response)
+            {
+                return response;
+            }
+            return strdup("No HTML tags found.\nTry another URL...\n\n\n\nPress BACK to return.");
+        }
+        else if (strstr(http_method, "BROWSE") != NULL)
         {
             // parse HTML then return response
             FuriString *returned_data = flipper_http_load_from_file(model->fhttp->file_path);
             if (returned_data == NULL || furi_string_size(returned_data) == 0)
             {
-                return "Failed to load HTML response.\n\n\n\n\nPress BACK to return.";
+                return strdup("Failed to load HTML response.\n\n\n\n\nPress BACK to return.");
+            }
+
+            // find every tag we display in a single pass over the page
+            const char *tags[] = {"<head>", "<title>", "<h1>", "<h2>", "<h3>", "<p>"};
+            size_t max_matches = 64;
+            HTMLFuriMatch *matches = (HTMLFuriMatch *)malloc(max_matches * sizeof(HTMLFuriMatch));
+            if (!matches)
+            {
+                furi_string_free(returned_data);
+                return strdup("Failed to parse HTML response.\n\n\n\n\nPress BACK to return.");
             }
+            size_t match_count = html_furi_extract(tags, COUNT_OF(tags), returned_data, matches, max_matches);
 
             // head is mandatory,
-            bool head_exists = html_furi_tag_exists("<head>", returned_data, 0);
+            bool head_exists = false;
+            for (size_t m = 0; m < match_count; m++)
+            {
+                if (matches[m].tag_index == 0)
+                {
+                    head_exists = true;
+                    break;
+                }
+            }
             if (!head_exists)
             {
                 FURI_LOG_E(TAG, "Invalid HTML response");
-                return "Invalid HTML response.\n\n\n\n\nPress BACK to return.";
+                free(matches);
+                furi_string_free(returned_data);
+                return strdup("Invalid HTML response.\n\n\n\n\nPress BACK to return.");
             }
 
             // optional tags but we'll append them the response in order (title -> h1 -> h2 -> h3 -> p)
             FuriString *response = furi_string_alloc();
-            if (html_furi_tag_exists("<title>", returned_data, 0))
-            {
-                FuriString *title = html_furi_find_tag("<title>", returned_data, 0);
-                furi_string_trim(title);
-                furi_string_cat_str(response, "Title: ");
-                furi_string_cat(response, title);
-                furi_string_cat_str(response, "\n\n");
-                furi_string_free(title);
-            }
-            if (html_furi_tag_exists("<h1>", returned_data, 0))
-            {
-                FuriString *h1 = html_furi_find_tag("<h1>", returned_data, 0);
-                furi_string_trim(h1);
-                furi_string_cat(response, h1);
-                furi_string_cat_str(response, "\n\n");
-                furi_string_free(h1);
-            }
-            if (html_furi_tag_exists("<h2>", returned_data, 0))
+            FuriString *content = furi_string_alloc();
+            const char *prefixes[] = {NULL, "Title: ", "", "", "", ""};
+            const char *suffixes[] = {NULL, "\n\n", "\n\n", "\n", "\n", "\n"};
+            for (size_t t = 1; t < COUNT_OF(tags); t++)
             {
-                FuriString *h2 = html_furi_find_tag("<h2>", returned_data, 0);
-                furi_string_trim(h2);
-                furi_string_cat(response, h2);
-                furi_string_cat_str(response, "\n");
-                furi_string_free(h2);
-            }
-            if (html_furi_tag_exists("<h3>", returned_data, 0))
-            {
-                FuriString *h3 = html_furi_find_tag("<h3>", returned_data, 0);
-                furi_string_trim(h3);
-                furi_string_cat(response, h3);
-                furi_string_cat_str(response, "\n");
-                furi_string_free(h3);
-            }
-            if (html_furi_tag_exists("<p>", returned_data, 0))
-            {
-                FuriString *p = html_furi_find_tags("<p>", returned_data);
-                furi_string_trim(p);
-                furi_string_cat(response, p);
-                furi_string_free(p);
+                for (size_t m = 0; m < match_count; m++)
+                {
+                    if (matches[m].tag_index != t)
+                    {
+                        continue;
+                    }
+                    furi_string_set_n(content, returned_data, matches[m].start, matches[m].length);
+                    html_furi_normalize_string(content);
+                    furi_string_cat_str(response, prefixes[t]);
+                    furi_string_cat(response, content);
+                    furi_string_cat_str(response, suffixes[t]);
+                    // only the first title and heading of each level, but every paragraph
+                    if (t != COUNT_OF(tags) - 1)
+                    {
+                        break;
+                    }
+                }
             }
+            furi_string_free(content);
+            free(matches);
+            furi_string_trim(response);
             furi_string_free(returned_data);
-            if (response && furi_string_size(response) > 0)
+            if (furi_string_size(response) > 0)
             {
-                return (char *)furi_string_get_cstr(response);
+                // the loader frees the result, so it gets a copy of its own
+                char *text = strdup(furi_string_get_cstr(response));
+                furi_string_free(response);
+                return text;
             }
-            return "No HTML tags found.\nTry another URL...\n\n\n\nPress BACK to return.";
+            furi_string_free(response);
+            return strdup("No HTML tags found.\nTry another URL...\n\n\n\nPress BACK to return.");
         }
     }
-    return "Data saved to file.\n\n\n\n\nPress BACK to return.";
+    if (model->cache_hit)
+    {
+        return strdup("Not modified.\nThe saved file is current.\n\n\n\nPress BACK to return.");
+    }
+    return strdup("Data saved to file.\n\n\n\n\nPress BACK to return.");
 }
 
 static void web_crawler_data_switch_to_view(WebCrawlerApp *app)
@@ -909,6 +1000,197 @@ static void web_crawler_data_switch_to_view(WebCrawlerApp *app)
     web_crawler_generic_switch_to_view(app, title, web_crawler_fetch, web_crawler_parse, 1, web_crawler_back_to_main_callback, WebCrawlerViewLoader);
 }
 
+static bool web_crawler_crawl_fetch(DataLoaderModel *model)
+{
+    WebCrawlerApp *app = (WebCrawlerApp *)model->parser_context;
+    furi_check(app, "web_crawler_crawl_fetch: WebCrawlerApp is NULL");
+    furi_check(model->fhttp, "web_crawler_crawl_fetch: FlipperHTTP is NULL");
+    if (model->request_index == 0)
+    {
+        app->crawl_offset = 0;
+    }
+    char url[128];
+    if (!crawl_list_read(&app->crawl_offset, url, sizeof(url)))
+    {
+        FURI_LOG_E(TAG, "Failed to read URL %u of the crawl list", (unsigned int)(model->request_index + 1));
+        return false;
+    }
+
+    // the request settings apply to every URL in the list; failures skip the URL instead of stopping the crawl
+    char file_type[16];
+    if (!load_char("file_type", file_type, sizeof(file_type)))
+    {
+        snprintf(file_type, sizeof(file_type), ".txt");
+    }
+    char http_method[16];
+    if (!load_char("http_method", http_method, sizeof(http_method)))
+    {
+        snprintf(http_method, sizeof(http_method), "GET");
+    }
+    char headers[256];
+    if (!load_char("headers", headers, sizeof(headers)))
+    {
+        headers[0] = '\0';
+    }
+    char payload[256];
+    if (!load_char("payload", payload, sizeof(payload)))
+    {
+        payload[0] = '\0';
+    }
+
+    // each response goes to its own file, numbered by its position in the list
+    Storage *storage = furi_record_open(RECORD_STORAGE);
+    storage_common_mkdir(storage, CRAWL_DATA_PATH);
+    furi_record_close(RECORD_STORAGE);
+    snprintf(
+        model->fhttp->file_path,
+        sizeof(model->fhttp->file_path),
+        CRAWL_DATA_PATH "/crawl_%03u%s",
+        (unsigned int)(model->request_index + 1),
+        file_type);
+
+    FURI_LOG_I(TAG, "Crawling %u/%u: %s", (unsigned int)(model->request_index + 1), (unsigned int)model->request_count, url);
+    return web_crawler_send_request(model, http_method, url, headers, payload);
+}
+
+static char *web_crawler_crawl_parse(DataLoaderModel *model)
+{
+    // responses were saved as they arrived; the loader shows the totals once the list is done
+    if (model->cache_hit)
+    {
+        return strdup("Not modified; the saved\nresponse in\napps_data/web_crawler/crawl/\nis current.");
+    }
+    return strdup("Responses saved to\napps_data/web_crawler/crawl/");
+}
+
+static void web_crawler_crawl_switch_to_view(WebCrawlerApp *app)
+{
+    furi_check(app, "web_crawler_crawl_switch_to_view: WebCrawlerApp is NULL");
+
+    size_t url_count = crawl_list_count();
+    if (url_count == 0)
+    {
+        easy_flipper_dialog("Error", "No URLs to crawl.\nAdd one URL per line to\napps_data/web_crawler/\nurls.txt");
+        return;
+    }
+    app->crawl_offset = 0;
+    web_crawler_generic_switch_to_view(app, "Crawl List", web_crawler_crawl_fetch, web_crawler_crawl_parse, url_count, web_crawler_back_to_main_callback, WebCrawlerViewLoader);
+}
+
+static bool web_crawler_site_fetch(DataLoaderModel *model)
+{
+    WebCrawlerApp *app = (WebCrawlerApp *)model->parser_context;
+    furi_check(app, "web_crawler_site_fetch: WebCrawlerApp is NULL");
+    furi_check(model->fhttp, "web_crawler_site_fetch: FlipperHTTP is NULL");
+    furi_check(app->crawl_engine, "web_crawler_site_fetch: CrawlEngine is NULL");
+    CrawlEngine *engine = app->crawl_engine;
+    if (!crawl_engine_next(engine))
+    {
+        // the frontier ran dry, so this request ends the crawl instead of failing
+        model->request_count = model->request_index;
+        return false;
+    }
+
+    // extract the page text and its links in the same pass as it downloads
+    if (!app->html_stream)
+    {
+        app->html_stream = html_furi_stream_alloc(MAX_FILE_SHOW);
+    }
+    if (!app->html_stream)
+    {
+        return false;
+    }
+    html_furi_stream_reset(app->html_stream);
+    if (crawl_engine_page_start(engine))
+    {
+        // called from the FlipperHTTP worker as the page streams in
+        html_furi_stream_set_link_callback(app->html_stream, crawl_engine_link_callback, engine);
+    }
+    else
+    {
+        html_furi_stream_set_link_callback(app->html_stream, NULL, NULL);
+    }
+    flipper_http_set_sink_parser(model->fhttp, html_furi_stream_feed, app->html_stream);
+    model->fhttp->save_received_data = false;
+    model->fhttp->is_bytes_request = true;
+
+    FURI_LOG_I(TAG, "Crawling depth %u: %s", (unsigned int)engine->current.depth, engine->current.url);
+    return flipper_http_get_request_bytes(model->fhttp, engine->current.url, "{\"Content-Type\": \"application/octet-stream\"}");
+}
+
+static char *web_crawler_site_parse(DataLoaderModel *model)
+{
+    WebCrawlerApp *app = (WebCrawlerApp *)model->parser_context;
+    furi_check(app, "web_crawler_site_parse: WebCrawlerApp is NULL");
+    furi_check(app->crawl_engine, "web_crawler_site_parse: CrawlEngine is NULL");
+    CrawlEngine *engine = app->crawl_engine;
+    flipper_http_set_sink_file(model->fhttp);
+
+    // parsers run on the GUI thread from the loader's process event, where the app's 4 KB stack has room for this
+    crawl_engine_page_end(engine);
+    if (app->html_stream)
+    {
+        html_furi_stream_set_link_callback(app->html_stream, NULL, NULL);
+        crawl_engine_page_done(engine, html_furi_stream_get_text(app->html_stream));
+    }
+    else
+    {
+        crawl_engine_page_done(engine, NULL);
+    }
+    if (engine->frontier_len == 0)
+    {
+        // nothing left to crawl, so this is the last page
+        model->request_count = model->request_index + 1;
+    }
+
+    char *result = malloc(128);
+    if (!result)
+    {
+        return NULL;
+    }
+    snprintf(
+        result,
+        128,
+        "%u pages saved, %u waiting.\n%u links scheduled, %u skipped.\nPages saved to\napps_data/web_crawler/site/\npages.txt",
+        (unsigned int)engine->fetched,
+        (unsigned int)engine->frontier_len,
+        (unsigned int)engine->scheduled,
+        (unsigned int)engine->skipped);
+    return result;
+}
+
+static void web_crawler_site_switch_to_view(WebCrawlerApp *app)
+{
+    furi_check(app, "web_crawler_site_switch_to_view: WebCrawlerApp is NULL");
+
+    char url[128];
+    if (!load_char("path", url, sizeof(url)))
+    {
+        easy_flipper_dialog("Error", "Failed to load URL.\nGo into Settings -> Request\n and enter a Path.");
+        return;
+    }
+
+    char start_url[CRAWL_ENGINE_URL_SIZE + 1];
+    if (!crawl_engine_resolve(NULL, url, start_url, sizeof(start_url)))
+    {
+        easy_flipper_dialog("Error", "The Path must be an\nhttp:// or https:// URL.");
+        return;
+    }
+
+    // an unfinished crawl of the same Path continues from its journal
+    if (app->crawl_engine)
+    {
+        crawl_engine_free(app->crawl_engine);
+    }
+    app->crawl_engine = crawl_engine_alloc(CRAWL_SITE_PATH, start_url, CRAWL_ENGINE_MAX_DEPTH, CRAWL_ENGINE_MAX_PER_HOST);
+    if (!app->crawl_engine)
+    {
+        easy_flipper_dialog("Error", "Failed to start the crawl.\nCheck the SD card.");
+        return;
+    }
+    web_crawler_generic_switch_to_view(app, app->crawl_engine->resumed ? "Resume Crawl" : "Crawl Site", web_crawler_site_fetch, web_crawler_site_parse, CRAWL_ENGINE_MAX_PAGES, web_crawler_back_to_main_callback, WebCrawlerViewLoader);
+}
+
 /**
  * @brief      Navigation callback to handle exiting from other views to the submenu.
  * @param      context   The context - WebCrawlerApp object.
@@ -978,6 +1260,12 @@ void web_crawler_submenu_callback(void *context, uint32_t index)
         case WebCrawlerSubmenuIndexRun:
             web_crawler_data_switch_to_view(app);
             break;
+        case WebCrawlerSubmenuIndexCrawl:
+            web_crawler_crawl_switch_to_view(app);
+            break;
+        case WebCrawlerSubmenuIndexSite:
+            web_crawler_site_switch_to_view(app);
+            break;
         case WebCrawlerSubmenuIndexAbout:
             free_all(app);
             if (!alloc_widget(app, WebCrawlerViewAbout))
@@ -1526,12 +1814,28 @@ void web_crawler_loader_draw_callback(Canvas *canvas, void *model)
     }
 
     DataLoaderModel *data_loader_model = (DataLoaderModel *)model;
-    SerialState http_state = data_loader_model->fhttp->state;
     DataState data_state = data_loader_model->data_state;
     char *title = data_loader_model->title;
 
     canvas_set_font(canvas, FontSecondary);
 
+    if (!data_loader_model->fhttp)
+    {
+        // the connect thread started on enter opens the connection
+        canvas_draw_str(canvas, 0, 7, title);
+        if (data_state == DataStateError)
+        {
+            canvas_draw_str(canvas, 0, 17, "The UART is busy.");
+            canvas_draw_str(canvas, 0, 27, "Retrying every second...");
+        }
+        else
+        {
+            canvas_draw_str(canvas, 0, 17, "Connecting...");
+        }
+        return;
+    }
+    SerialState http_state = data_loader_model->fhttp->state;
+
     if (http_state == INACTIVE)
     {
         canvas_draw_str(canvas, 0, 7, "Wifi Dev Board disconnected.");
@@ -1552,6 +1856,19 @@ void web_crawler_loader_draw_callback(Canvas *canvas, void *model)
     canvas_draw_str(canvas, 0, 7, title);
     canvas_draw_str(canvas, 0, 17, "Loading...");
 
+    if (data_loader_model->batch)
+    {
+        char progress[32];
+        snprintf(
+            progress,
+            sizeof(progress),
+            "%u/%u (%u failed)",
+            (unsigned int)(data_loader_model->request_index + 1),
+            (unsigned int)data_loader_model->request_count,
+            (unsigned int)data_loader_model->request_failures);
+        canvas_draw_str_aligned(canvas, 128, 17, AlignRight, AlignBottom, progress);
+    }
+
     if (data_state == DataStateInitial)
     {
         return;
@@ -1582,6 +1899,25 @@ void web_crawler_loader_draw_callback(Canvas *canvas, void *model)
     }
 }
 
+// Function to handle a failed request: a single request stops with an error, a batch skips to its next request
+static void web_crawler_loader_request_failed(DataLoaderModel *model)
+{
+    if (model->batch)
+    {
+        // a fetcher that shrank request_count to request_index ended the batch early, which is not a failure
+        if (model->request_index < model->request_count)
+        {
+            FURI_LOG_E(TAG, "Request %u of %u failed, skipping it", (unsigned int)(model->request_index + 1), (unsigned int)model->request_count);
+            model->request_failures++;
+        }
+        model->data_state = DataStateParsed; // the parsed step moves on to the next request
+    }
+    else
+    {
+        model->data_state = DataStateError;
+    }
+}
+
 static void web_crawler_loader_process_callback(void *context)
 {
     if (context == NULL)
@@ -1597,15 +1933,20 @@ static void web_crawler_loader_process_callback(void *context)
     DataState current_data_state;
     DataLoaderModel *loader_model = NULL;
     with_view_model(view, DataLoaderModel * model, { current_data_state = model->data_state; loader_model = model; }, false);
-    if (!loader_model || !loader_model->fhttp)
+    if (!loader_model)
     {
-        FURI_LOG_E(TAG, "Model or fhttp is NULL");
+        FURI_LOG_E(TAG, "Model is NULL");
         DEV_CRASH();
         return;
     }
+    if (!loader_model->fhttp)
+    {
+        return; // still connecting to the board
+    }
 
     if (current_data_state == DataStateInitial)
     {
+        bool skipped = false;
         with_view_model(
             view,
             DataLoaderModel * model,
@@ -1621,13 +1962,22 @@ static void web_crawler_loader_process_callback(void *context)
 
                 // Clear any previous responses
                 strncpy(model->fhttp->last_response, "", 1);
+                model->cache_url[0] = '\0';
+                model->conditional = false;
+                model->cache_hit = false;
                 bool request_status = fetch(model);
                 if (!request_status)
                 {
-                    model->data_state = DataStateError;
+                    web_crawler_loader_request_failed(model);
+                    skipped = model->data_state == DataStateParsed;
                 }
             },
             true);
+        if (skipped)
+        {
+            // Move on to the next request right away
+            view_dispatcher_send_custom_event(app->view_dispatcher, WebCrawlerCustomEventProcess);
+        }
     }
     else if (current_data_state == DataStateRequested || current_data_state == DataStateError)
     {
@@ -1649,9 +1999,17 @@ static void web_crawler_loader_process_callback(void *context)
             {
                 // Still waiting on response
             }
+            else if (loader_model->fhttp->request_dropped > 0)
+            {
+                // The response arrived with holes in it; parsing or keeping it would pass on corrupted data
+                with_view_model(view, DataLoaderModel * model, { web_crawler_loader_request_failed(model); }, true);
+                view_dispatcher_send_custom_event(app->view_dispatcher, WebCrawlerCustomEventProcess);
+            }
             else
             {
                 with_view_model(view, DataLoaderModel * model, { model->data_state = DataStateReceived; }, true);
+                // Parse right away rather than waiting for the next timer tick
+                view_dispatcher_send_custom_event(app->view_dispatcher, WebCrawlerCustomEventProcess);
             }
         }
         else if (loader_model->fhttp->state == SENDING || loader_model->fhttp->state == RECEIVING)
@@ -1662,9 +2020,31 @@ static void web_crawler_loader_process_callback(void *context)
         {
             // inactive. try again
         }
+        else if (loader_model->fhttp->state == ISSUE && current_data_state == DataStateRequested &&
+                 loader_model->conditional && cache_not_modified(loader_model->fhttp->last_response))
+        {
+            // 304: the response saved last time is still current
+            FURI_LOG_I(TAG, "Not modified: %s", loader_model->cache_url);
+            with_view_model(
+                view,
+                DataLoaderModel * model,
+                {
+                    // the worker is done with the response once its error line set ISSUE
+                    model->fhttp->state = IDLE;
+                    model->cache_hit = true;
+                    model->data_state = DataStateReceived;
+                },
+                true);
+            view_dispatcher_send_custom_event(app->view_dispatcher, WebCrawlerCustomEventProcess);
+        }
+        else if (loader_model->fhttp->state == ISSUE && current_data_state == DataStateRequested)
+        {
+            with_view_model(view, DataLoaderModel * model, { web_crawler_loader_request_failed(model); }, true);
+            view_dispatcher_send_custom_event(app->view_dispatcher, WebCrawlerCustomEventProcess);
+        }
         else if (loader_model->fhttp->state == ISSUE)
         {
-            with_view_model(view, DataLoaderModel * model, { model->data_state = DataStateError; }, true);
+            // already reported
         }
         else
         {
@@ -1687,9 +2067,19 @@ static void web_crawler_loader_process_callback(void *context)
                 }
                 else
                 {
+                    if (model->cache_url[0] != '\0' && !model->cache_hit)
+                    {
+                        // remember the new response so the next GET of the URL can be conditional
+                        cache_store(model->cache_url, model->fhttp->file_path);
+                    }
                     data_text = model->parser(model);
                 }
                 FURI_LOG_DEV(TAG, "Parsed data: %s\r\ntext: %s", model->fhttp->last_response ? model->fhttp->last_response : "NULL", data_text ? data_text : "NULL");
+                if (model->data_text != NULL)
+                {
+                    // the previous result of a batch is replaced; every parser returns a heap string
+                    free(model->data_text);
+                }
                 model->data_text = data_text;
                 if (data_text == NULL)
                 {
@@ -1701,6 +2091,8 @@ static void web_crawler_loader_process_callback(void *context)
                 }
             },
             true);
+        // Show the result right away rather than waiting for the next timer tick
+        view_dispatcher_send_custom_event(app->view_dispatcher, WebCrawlerCustomEventProcess);
     }
     else if (current_data_state == DataStateParsed)
     {
@@ -1712,6 +2104,27 @@ static void web_crawler_loader_process_callback(void *context)
                 {
                     model->data_state = DataStateInitial;
                 }
+                else if (model->batch)
+                {
+                    // a batch ends with its totals and the result of its last successful request
+                    char summary[256];
+                    snprintf(
+                        summary,
+                        sizeof(summary),
+                        "Finished %u of %u requests.\n%u failed.\n\n%s\n\nPress BACK to return.",
+                        (unsigned int)(model->request_count - model->request_failures),
+                        (unsigned int)model->request_count,
+                        (unsigned int)model->request_failures,
+                        model->data_text != NULL ? model->data_text : "");
+                    web_crawler_widget_set_text(summary, &app->widget_result);
+                    if (model->data_text != NULL)
+                    {
+                        free(model->data_text);
+                        model->data_text = NULL;
+                    }
+                    view_set_previous_callback(widget_get_view(app->widget_result), model->back_callback);
+                    view_dispatcher_switch_to_view(app->view_dispatcher, WebCrawlerViewWidgetResult);
+                }
                 else
                 {
                     web_crawler_widget_set_text(model->data_text != NULL ? model->data_text : "", &app->widget_result);
@@ -1728,6 +2141,78 @@ static void web_crawler_loader_process_callback(void *context)
     }
 }
 
+// Function to process a response as soon as it finishes instead of on the next timer tick
+// Runs on the FlipperHTTP worker, so it only queues the event
+static void web_crawler_loader_complete_callback(void *context)
+{
+    WebCrawlerApp *app = (WebCrawlerApp *)context;
+    view_dispatcher_send_custom_event(app->view_dispatcher, WebCrawlerCustomEventProcess);
+}
+
+// Function to open the loader's connection to the board, once for as long as the app runs
+// Runs on its own thread: the board's answers take seconds, which must not block the GUI thread,
+// the shared timer thread or be waited for while holding the view model
+static int32_t web_crawler_loader_connect_thread(void *context)
+{
+    WebCrawlerApp *app = (WebCrawlerApp *)context;
+    View *view = app->view_loader;
+    bool stop = false;
+
+    FlipperHTTP *fhttp = flipper_http_alloc();
+    while (!fhttp)
+    {
+        // another app holds the UART; keep trying until it lets go or the app exits
+        FURI_LOG_E(TAG, "Failed to allocate FlipperHTTP, retrying");
+        with_view_model(view, DataLoaderModel * model, { model->data_state = DataStateError; stop = model->connect_stop; }, true);
+        if (stop)
+        {
+            return 0;
+        }
+        furi_delay_ms(LOADER_CONNECT_RETRY_MS);
+        fhttp = flipper_http_alloc();
+    }
+
+    // The loader keeps its connection, so a faster baud rate is worth asking a board that answers.
+    // Ask it to pause instead of overrunning the RX buffer, to frame what it sends, so binary
+    // responses are saved exactly, and to compress the bodies in those frames;
+    // older firmware keeps sending lines freely
+    if (flipper_http_ping_wait(fhttp, PING_TIMEOUT_MS))
+    {
+        flipper_http_negotiate_baudrate(fhttp);
+        flipper_http_flow_control(fhttp, true);
+        if (flipper_http_framing(fhttp, true))
+        {
+            flipper_http_compression(fhttp, true);
+        }
+    }
+    flipper_http_set_complete_callback(fhttp, web_crawler_loader_complete_callback, app);
+
+    with_view_model(
+        view,
+        DataLoaderModel * model,
+        {
+            stop = model->connect_stop;
+            if (!stop)
+            {
+                model->fhttp = fhttp;
+                if (model->data_state == DataStateError)
+                {
+                    model->data_state = DataStateInitial; // the UART was busy before, not the request
+                }
+            }
+        },
+        true);
+    if (stop)
+    {
+        flipper_http_free(fhttp);
+        return 0;
+    }
+
+    // start the first request now instead of on the next timer tick
+    view_dispatcher_send_custom_event(app->view_dispatcher, WebCrawlerCustomEventProcess);
+    return 0;
+}
+
 static void web_crawler_loader_timer_callback(void *context)
 {
     if (context == NULL)
@@ -1760,6 +2245,13 @@ static void web_crawler_loader_on_enter(void *context)
                 model->timer = furi_timer_alloc(web_crawler_loader_timer_callback, FuriTimerTypePeriodic, app);
             }
             furi_timer_start(model->timer, 250);
+            if (model->fhttp == NULL && model->connect_thread == NULL)
+            {
+                // the deepest path, a negotiation command through flipper_http_send_data, uses about 0.7 KB
+                model->connect_stop = false;
+                model->connect_thread = furi_thread_alloc_ex("WebCrawlerConnect", 2048, web_crawler_loader_connect_thread, app);
+                furi_thread_start(model->connect_thread);
+            }
         },
         true);
 }
@@ -1807,6 +2299,14 @@ void web_crawler_loader_free_model(View *view)
         DEV_CRASH();
         return;
     }
+    // the connect thread takes the model lock, so it is joined without holding it
+    FuriThread *connect_thread = NULL;
+    with_view_model(view, DataLoaderModel * model, { model->connect_stop = true; connect_thread = model->connect_thread; model->connect_thread = NULL; }, false);
+    if (connect_thread)
+    {
+        furi_thread_join(connect_thread);
+        furi_thread_free(connect_thread);
+    }
     with_view_model(
         view,
         DataLoaderModel * model,
@@ -1872,20 +2372,24 @@ void web_crawler_generic_switch_to_view(WebCrawlerApp *app, char *title, DataLoa
         view,
         DataLoaderModel * model,
         {
+            if (model->data_text != NULL && model->batch)
+            {
+                // left over from a batch that was cancelled with BACK
+                free(model->data_text);
+            }
             model->title = title;
             model->fetcher = fetcher;
             model->parser = parser;
             model->request_index = 0;
             model->request_count = request_count;
+            model->request_failures = 0;
+            model->batch = request_count > 1;
             model->back_callback = back;
             model->data_state = DataStateInitial;
             model->data_text = NULL;
             //
             model->parser_context = app;
-            if (!model->fhttp)
-            {
-                model->fhttp = flipper_http_alloc();
-            }
+            // the connection is opened when the loader is entered, see web_crawler_loader_connect_thread
         },
         true);
 
@@ -2,6 +2,7 @@
 #define WEB_CRAWLER_CALLBACK_H
 #include "web_crawler.h"
 #include <flip_storage/web_crawler_storage.h>
+#include <flip_storage/web_crawler_cache.h>
 
 void web_crawler_http_method_change(VariableItem *item);
 uint32_t web_crawler_back_to_main_callback(void *context);
@@ -135,8 +136,15 @@ struct DataLoaderModel
     void *parser_context;
     size_t request_index;
     size_t request_count;
+    size_t request_failures; // Requests of a batch that failed and were skipped
+    bool batch;              // Indicates if failed requests are skipped and the loader ends with a summary
+    char cache_url[128];     // URL of the GET whose response is cached once it arrives, empty for other requests
+    bool conditional;        // Indicates if the GET asked for the response only if it changed
+    bool cache_hit;          // Indicates if the server reported the saved response unchanged
     ViewNavigationCallback back_callback;
     FuriTimer *timer;
+    FuriThread *connect_thread; // Opens fhttp off the GUI and timer threads
+    bool connect_stop;          // Tells the connect thread to give up, set when the app exits
     FlipperHTTP *fhttp;
 };
 
@@ -0,0 +1,148 @@
+#include <crawl/crawl_bloom.h>
+#include <math.h>
+
+#define BLOOM_TAG "crawl_bloom"
+
+// 64-bit FNV-1a hash; its halves are the two hashes combined for each bit
+static uint64_t crawl_bloom_hash(const char *key, size_t len)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < len; i++)
+    {
+        hash ^= (uint8_t)key[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+CrawlBloom *crawl_bloom_alloc(size_t capacity, float false_positive_rate)
+{
+    if (capacity == 0 || false_positive_rate <= 0.0f || false_positive_rate >= 1.0f)
+    {
+        FURI_LOG_E(BLOOM_TAG, "Invalid Bloom filter size");
+        return NULL;
+    }
+
+    // optimal size: bits = -n ln(p) / ln(2)^2, hashes = bits / n * ln(2)
+    float ln2 = logf(2.0f);
+    uint32_t bits = (uint32_t)ceilf(-(float)capacity * logf(false_positive_rate) / (ln2 * ln2));
+    bits = (bits + 7) & ~7u;
+    uint32_t hashes = (uint32_t)lroundf((float)bits / (float)capacity * ln2);
+    hashes = CLAMP(hashes, CRAWL_BLOOM_MAX_HASHES, 1u);
+
+    CrawlBloom *bloom = (CrawlBloom *)malloc(sizeof(CrawlBloom));
+    if (!bloom)
+    {
+        FURI_LOG_E(BLOOM_TAG, "Failed to allocate Bloom filter");
+        return NULL;
+    }
+    bloom->data = (uint8_t *)malloc(bits / 8);
+    if (!bloom->data)
+    {
+        FURI_LOG_E(BLOOM_TAG, "Failed to allocate %lu Bloom filter bits", bits);
+        free(bloom);
+        return NULL;
+    }
+    bloom->bits = bits;
+    bloom->hashes = hashes;
+    crawl_bloom_clear(bloom);
+    return bloom;
+}
+
+void crawl_bloom_free(CrawlBloom *bloom)
+{
+    if (!bloom)
+    {
+        return;
+    }
+    free(bloom->data);
+    free(bloom);
+}
+
+void crawl_bloom_clear(CrawlBloom *bloom)
+{
+    memset(bloom->data, 0, bloom->bits / 8);
+    bloom->count = 0;
+}
+
+bool crawl_bloom_contains(const CrawlBloom *bloom, const char *key, size_t len)
+{
+    uint64_t hash = crawl_bloom_hash(key, len);
+    uint32_t h1 = (uint32_t)hash;
+    uint32_t h2 = (uint32_t)(hash >> 32) | 1;
+    for (uint32_t i = 0; i < bloom->hashes; i++)
+    {
+        uint32_t bit = (h1 + i * h2) % bloom->bits;
+        if (!(bloom->data[bit / 8] & (1 << (bit % 8))))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool crawl_bloom_add(CrawlBloom *bloom, const char *key, size_t len)
+{
+    uint64_t hash = crawl_bloom_hash(key, len);
+    uint32_t h1 = (uint32_t)hash;
+    uint32_t h2 = (uint32_t)(hash >> 32) | 1;
+    bool added = false;
+    for (uint32_t i = 0; i < bloom->hashes; i++)
+    {
+        uint32_t bit = (h1 + i * h2) % bloom->bits;
+        uint8_t mask = 1 << (bit % 8);
+        if (!(bloom->data[bit / 8] & mask))
+        {
+            bloom->data[bit / 8] |= mask;
+            added = true;
+        }
+    }
+    if (added)
+    {
+        bloom->count++;
+    }
+    return added;
+}
+
+bool crawl_bloom_save(const CrawlBloom *bloom, File *file)
+{
+    CrawlBloomHeader header = {
+        .magic = CRAWL_BLOOM_MAGIC,
+        .version = CRAWL_BLOOM_VERSION,
+        .hashes = bloom->hashes,
+        .bits = bloom->bits,
+        .count = bloom->count,
+    };
+    if (storage_file_write(file, &header, sizeof(header)) != sizeof(header) ||
+        storage_file_write(file, bloom->data, bloom->bits / 8) != bloom->bits / 8)
+    {
+        FURI_LOG_E(BLOOM_TAG, "Failed to save Bloom filter");
+        return false;
+    }
+    return true;
+}
+
+bool crawl_bloom_load(CrawlBloom *bloom, File *file)
+{
+    CrawlBloomHeader header;
+    if (storage_file_read(file, &header, sizeof(header)) != sizeof(header) ||
+        header.magic != CRAWL_BLOOM_MAGIC ||
+        header.version != CRAWL_BLOOM_VERSION)
+    {
+        FURI_LOG_E(BLOOM_TAG, "No saved Bloom filter");
+        return false;
+    }
+    if (header.bits != bloom->bits || header.hashes != bloom->hashes)
+    {
+        FURI_LOG_E(BLOOM_TAG, "Saved Bloom filter has a different size");
+        return false;
+    }
+    if (storage_file_read(file, bloom->data, bloom->bits / 8) != bloom->bits / 8)
+    {
+        FURI_LOG_E(BLOOM_TAG, "Saved Bloom filter is truncated");
+        crawl_bloom_clear(bloom);
+        return false;
+    }
+    bloom->count = header.count;
+    return true;
+}
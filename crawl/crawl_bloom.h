@@ -0,0 +1,81 @@
+#pragma once
+#include <furi.h>
+#include <storage/storage.h>
+
+#define CRAWL_BLOOM_MAGIC 0x46424C43 // "CLBF", marks a saved Bloom filter
+#define CRAWL_BLOOM_VERSION 1        // Version of the saved format
+#define CRAWL_BLOOM_MAX_HASHES 16    // Most bits set per key
+
+// Header written before the bit array by crawl_bloom_save
+typedef struct
+{
+    uint32_t magic;   // CRAWL_BLOOM_MAGIC
+    uint16_t version; // CRAWL_BLOOM_VERSION
+    uint16_t hashes;  // Bits set per key
+    uint32_t bits;    // Size of the bit array
+    uint32_t count;   // Keys added
+} CrawlBloomHeader;
+
+// Fixed-size probabilistic set: it never misses a key that was added, but may report
+// a key that was never added at about the false positive rate it was sized for
+typedef struct
+{
+    uint32_t bits;   // Size of the bit array, a multiple of 8
+    uint32_t hashes; // Bits set per key
+    uint32_t count;  // Keys added
+    uint8_t *data;   // The bit array
+} CrawlBloom;
+
+/*
+ * @brief Allocate an empty Bloom filter sized for a number of keys and a false positive rate.
+ * @param capacity The number of keys the filter is expected to hold.
+ * @param false_positive_rate The chance that a key never added is reported, once capacity keys were added (e.g. 0.01).
+ * @return The Bloom filter, or NULL on failure.
+ */
+CrawlBloom *crawl_bloom_alloc(size_t capacity, float false_positive_rate);
+
+/*
+ * @brief Free a Bloom filter.
+ * @param bloom The Bloom filter to free.
+ */
+void crawl_bloom_free(CrawlBloom *bloom);
+
+/*
+ * @brief Remove every key from a Bloom filter.
+ * @param bloom The Bloom filter.
+ */
+void crawl_bloom_clear(CrawlBloom *bloom);
+
+/*
+ * @brief Check if a key may have been added.
+ * @param bloom The Bloom filter.
+ * @param key The key.
+ * @param len The length of the key.
+ * @return true if the key was probably added, false if it was definitely not.
+ */
+bool crawl_bloom_contains(const CrawlBloom *bloom, const char *key, size_t len);
+
+/*
+ * @brief Add a key.
+ * @param bloom The Bloom filter.
+ * @param key The key.
+ * @param len The length of the key.
+ * @return true if the key was new, false if it was probably added before.
+ */
+bool crawl_bloom_add(CrawlBloom *bloom, const char *key, size_t len);
+
+/*
+ * @brief Write a Bloom filter to an open file as a CrawlBloomHeader followed by the bit array.
+ * @param bloom The Bloom filter.
+ * @param file The file, positioned where the filter is written.
+ * @return true if the filter was written, false otherwise.
+ */
+bool crawl_bloom_save(const CrawlBloom *bloom, File *file);
+
+/*
+ * @brief Read a Bloom filter written by crawl_bloom_save.
+ * @param bloom The Bloom filter, which must have the same size and hash count as the saved one.
+ * @param file The file, positioned where the filter starts.
+ * @return true if the filter was read, false if the file does not hold a matching filter.
+ */
+bool crawl_bloom_load(CrawlBloom *bloom, File *file);
@@ -0,0 +1,885 @@
+#include <crawl/crawl_engine.h>
+#include <html/html_furi.h>
+#include <ctype.h>
+
+#define CRAWL_TAG "crawl_engine"
+
+// File extensions of links that are not pages, so they are never fetched
+static const char *crawl_engine_skipped_extensions[] = {
+    ".jpg", ".jpeg", ".png", ".gif", ".svg", ".ico", ".webp", ".bmp",
+    ".pdf", ".zip", ".gz", ".mp3", ".mp4", ".css", ".js", ".woff", ".woff2"};
+
+// 32-bit FNV-1a hash; 0 marks an empty slot, so it is never returned
+static uint32_t crawl_engine_hash(const char *data, size_t len)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++)
+    {
+        hash ^= (uint8_t)data[i];
+        hash *= 16777619u;
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+// Length of "scheme://host[:port]" at the start of an absolute URL, or 0 if it has none
+static size_t crawl_engine_origin_len(const char *url)
+{
+    const char *authority = strstr(url, "://");
+    if (!authority || authority == url)
+    {
+        return 0;
+    }
+    authority += 3;
+    return (authority - url) + strcspn(authority, "/?#");
+}
+
+static bool crawl_engine_append(char *out, size_t out_size, size_t *len, const char *text, size_t text_len)
+{
+    if (*len + text_len >= out_size)
+    {
+        return false;
+    }
+    memcpy(&out[*len], text, text_len);
+    *len += text_len;
+    out[*len] = '\0';
+    return true;
+}
+
+// Remove "." and ".." segments from the path of an absolute URL, in place
+static void crawl_engine_remove_dot_segments(char *path)
+{
+    size_t path_end = strcspn(path, "?");
+    size_t read = 0;
+    size_t write = 0;
+    while (read < path_end)
+    {
+        // path[read] is the '/' before a segment
+        size_t segment_start = read + 1;
+        size_t segment_end = segment_start;
+        while (segment_end < path_end && path[segment_end] != '/')
+        {
+            segment_end++;
+        }
+        size_t segment_len = segment_end - segment_start;
+        bool last = segment_end == path_end;
+        if (segment_len == 1 && path[segment_start] == '.')
+        {
+            if (last)
+            {
+                path[write++] = '/';
+            }
+        }
+        else if (segment_len == 2 && path[segment_start] == '.' && path[segment_start + 1] == '.')
+        {
+            // drop the last segment written
+            while (write > 0 && path[write - 1] != '/')
+            {
+                write--;
+            }
+            if (write > 0)
+            {
+                write--;
+            }
+            if (last)
+            {
+                path[write++] = '/';
+            }
+        }
+        else
+        {
+            path[write++] = '/';
+            memmove(&path[write], &path[segment_start], segment_len);
+            write += segment_len;
+        }
+        read = segment_end;
+    }
+    if (write == 0)
+    {
+        path[write++] = '/';
+    }
+    memmove(&path[write], &path[path_end], strlen(&path[path_end]) + 1);
+}
+
+// Lowercase the scheme and host, drop default ports and resolve the path of an absolute URL, in place
+static bool crawl_engine_normalize(char *url, size_t url_size)
+{
+    size_t origin_len = crawl_engine_origin_len(url);
+    if (origin_len == 0)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < origin_len; i++)
+    {
+        url[i] = tolower((unsigned char)url[i]);
+    }
+    bool https = strncmp(url, "https://", 8) == 0;
+    if (!https && strncmp(url, "http://", 7) != 0)
+    {
+        return false;
+    }
+    size_t host_start = https ? 8 : 7;
+    if (origin_len == host_start)
+    {
+        return false; // no host
+    }
+
+    const char *default_port = https ? ":443" : ":80";
+    size_t port_len = strlen(default_port);
+    if (origin_len - host_start > port_len && strncmp(&url[origin_len - port_len], default_port, port_len) == 0)
+    {
+        memmove(&url[origin_len - port_len], &url[origin_len], strlen(&url[origin_len]) + 1);
+        origin_len -= port_len;
+    }
+
+    // the path always starts with '/'
+    if (url[origin_len] != '/')
+    {
+        size_t len = strlen(url);
+        if (len + 1 >= url_size)
+        {
+            return false;
+        }
+        memmove(&url[origin_len + 1], &url[origin_len], len - origin_len + 1);
+        url[origin_len] = '/';
+    }
+    crawl_engine_remove_dot_segments(&url[origin_len]);
+    return true;
+}
+
+bool crawl_engine_resolve(const char *base, const char *href, char *out, size_t out_size)
+{
+    if (!href || !out || out_size == 0)
+    {
+        return false;
+    }
+
+    // decode entities such as &amp; and drop surrounding whitespace and the fragment
+    char link[CRAWL_ENGINE_URL_SIZE + 1];
+    size_t link_len = 0;
+    while (isspace((unsigned char)*href))
+    {
+        href++;
+    }
+    for (const char *p = href; *p != '\0' && *p != '#'; p++)
+    {
+        char c = *p;
+        if (c == '&')
+        {
+            const char *end = p + 1;
+            while (*end != '\0' && *end != ';' && (size_t)(end - p) <= HTML_FURI_ENTITY_SIZE)
+            {
+                end++;
+            }
+            char decoded[HTML_FURI_ENTITY_TEXT_SIZE];
+            if (*end == ';' && html_furi_decode_entity(p + 1, end - p - 1, decoded) == 1)
+            {
+                c = decoded[0];
+                p = end;
+            }
+        }
+        if (link_len >= CRAWL_ENGINE_URL_SIZE)
+        {
+            return false;
+        }
+        link[link_len++] = c;
+    }
+    while (link_len > 0 && isspace((unsigned char)link[link_len - 1]))
+    {
+        link_len--;
+    }
+    link[link_len] = '\0';
+    if (link_len == 0)
+    {
+        return false; // a fragment of the same page
+    }
+
+    size_t len = 0;
+    out[0] = '\0';
+    size_t scheme_len = strcspn(link, ":/?");
+    if (link[scheme_len] == ':')
+    {
+        // absolute, possibly mailto: or javascript:, which normalizing rejects
+        if (!crawl_engine_append(out, out_size, &len, link, link_len))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        if (!base)
+        {
+            return false;
+        }
+        size_t base_origin_len = crawl_engine_origin_len(base);
+        if (base_origin_len == 0)
+        {
+            return false;
+        }
+        bool appended;
+        if (link[0] == '/' && link[1] == '/')
+        {
+            // same scheme, other host
+            appended = crawl_engine_append(out, out_size, &len, base, strcspn(base, ":") + 1);
+        }
+        else if (link[0] == '/')
+        {
+            appended = crawl_engine_append(out, out_size, &len, base, base_origin_len);
+        }
+        else if (link[0] == '?')
+        {
+            appended = crawl_engine_append(out, out_size, &len, base, strcspn(base, "?"));
+        }
+        else
+        {
+            // relative to the directory of the base path
+            size_t base_path_end = strcspn(base, "?");
+            size_t base_dir_len = base_path_end;
+            while (base_dir_len > base_origin_len && base[base_dir_len - 1] != '/')
+            {
+                base_dir_len--;
+            }
+            appended = crawl_engine_append(out, out_size, &len, base, base_dir_len);
+            if (appended && base_dir_len == base_origin_len)
+            {
+                appended = crawl_engine_append(out, out_size, &len, "/", 1);
+            }
+        }
+        if (!appended || !crawl_engine_append(out, out_size, &len, link, link_len))
+        {
+            return false;
+        }
+    }
+    return crawl_engine_normalize(out, out_size);
+}
+
+// Open a crawl file left by an earlier run
+static File *crawl_engine_open_existing(CrawlEngine *engine, const char *name)
+{
+    char path[96];
+    snprintf(path, sizeof(path), "%s/%s", engine->directory, name);
+    File *file = storage_file_alloc(engine->storage);
+    if (!storage_file_open(file, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING))
+    {
+        storage_file_free(file);
+        return NULL;
+    }
+    return file;
+}
+
+// Create a crawl file, filled with zeros when it backs a fixed-size structure
+static File *crawl_engine_open(CrawlEngine *engine, const char *name, size_t size)
+{
+    char path[96];
+    snprintf(path, sizeof(path), "%s/%s", engine->directory, name);
+    File *file = storage_file_alloc(engine->storage);
+    if (!storage_file_open(file, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS))
+    {
+        FURI_LOG_E(CRAWL_TAG, "Failed to open crawl file: %s", path);
+        storage_file_free(file);
+        return NULL;
+    }
+    uint8_t zeros[256];
+    memset(zeros, 0, sizeof(zeros));
+    for (size_t written = 0; written < size; written += sizeof(zeros))
+    {
+        size_t chunk = MIN(sizeof(zeros), size - written);
+        if (storage_file_write(file, zeros, chunk) != chunk)
+        {
+            FURI_LOG_E(CRAWL_TAG, "Failed to size crawl file: %s", path);
+            storage_file_close(file);
+            storage_file_free(file);
+            return NULL;
+        }
+    }
+    return file;
+}
+
+static void crawl_engine_close(File **file)
+{
+    if (*file)
+    {
+        storage_file_close(*file);
+        storage_file_free(*file);
+        *file = NULL;
+    }
+}
+
+// Find a key in an open-addressed table of {key, value} slots, or the empty slot it belongs in
+static bool crawl_engine_table_find(File *file, size_t slots, uint32_t key, size_t *slot, uint32_t *value)
+{
+    *slot = SIZE_MAX; // the probed slots are all taken
+    for (size_t probe = 0; probe < CRAWL_ENGINE_PROBE_LIMIT; probe++)
+    {
+        size_t index = (key + probe) % slots;
+        uint32_t entry[2];
+        if (!storage_file_seek(file, index * sizeof(entry), true) ||
+            storage_file_read(file, entry, sizeof(entry)) != sizeof(entry))
+        {
+            return false;
+        }
+        if (entry[0] == key)
+        {
+            *slot = index;
+            *value = entry[1];
+            return true;
+        }
+        if (entry[0] == 0)
+        {
+            *slot = index;
+            return false;
+        }
+    }
+    return false;
+}
+
+static bool crawl_engine_table_write(File *file, size_t slot, uint32_t key, uint32_t value)
+{
+    uint32_t entry[2] = {key, value};
+    return storage_file_seek(file, slot * sizeof(entry), true) &&
+           storage_file_write(file, entry, sizeof(entry)) == sizeof(entry);
+}
+
+// Save the visited set; the journal replays any URL added after the last save
+static bool crawl_engine_save_visited(CrawlEngine *engine)
+{
+    File *file = crawl_engine_open(engine, "visited.bin", 0);
+    if (!file)
+    {
+        return false;
+    }
+    bool success = crawl_bloom_save(engine->visited, file);
+    crawl_engine_close(&file);
+    return success;
+}
+
+static bool crawl_engine_load_visited(CrawlEngine *engine)
+{
+    File *file = crawl_engine_open_existing(engine, "visited.bin");
+    if (!file)
+    {
+        return false;
+    }
+    bool success = crawl_bloom_load(engine->visited, file);
+    crawl_engine_close(&file);
+    return success;
+}
+
+// Append a record to the journal
+static bool crawl_engine_journal(CrawlEngine *engine, CrawlJournalType type, uint8_t value, uint32_t offset, const char *url, size_t url_len)
+{
+    CrawlJournalRecord record = {
+        .type = type,
+        .value = value,
+        .length = url_len,
+        .offset = offset,
+    };
+    if (!storage_file_seek(engine->journal, storage_file_size(engine->journal), true) ||
+        storage_file_write(engine->journal, &record, sizeof(record)) != sizeof(record) ||
+        (url_len > 0 && storage_file_write(engine->journal, url, url_len) != url_len))
+    {
+        FURI_LOG_E(CRAWL_TAG, "Failed to write to the journal");
+        return false;
+    }
+    return true;
+}
+
+// Read the journal record at *position, advancing past it; false at the end or at a torn record
+static bool crawl_engine_journal_read(CrawlEngine *engine, size_t *position, CrawlJournalRecord *record, char *url)
+{
+    if (!storage_file_seek(engine->journal, *position, true) ||
+        storage_file_read(engine->journal, record, sizeof(CrawlJournalRecord)) != sizeof(CrawlJournalRecord) ||
+        record->type < CrawlJournalStart || record->type > CrawlJournalRequeue ||
+        record->length > CRAWL_ENGINE_URL_SIZE ||
+        storage_file_read(engine->journal, url, record->length) != record->length)
+    {
+        return false;
+    }
+    url[record->length] = '\0';
+    *position += sizeof(CrawlJournalRecord) + record->length;
+    return true;
+}
+
+// Make sure the frontier entries and journal records written so far survive losing power
+static void crawl_engine_sync(CrawlEngine *engine)
+{
+    storage_file_sync(engine->frontier);
+    storage_file_sync(engine->journal);
+}
+
+// Look up how many URLs were scheduled for the host of a URL
+static void crawl_engine_host_find(CrawlEngine *engine, const char *url, uint32_t *key, size_t *slot, uint32_t *count)
+{
+    size_t host_start = strstr(url, "://") - url + 3;
+    *key = crawl_engine_hash(&url[host_start], crawl_engine_origin_len(url) - host_start);
+    *count = 0;
+    crawl_engine_table_find(engine->hosts, CRAWL_ENGINE_HOST_SLOTS, *key, slot, count);
+}
+
+// Write a URL to the tail of the frontier and journal it
+static bool crawl_engine_push(CrawlEngine *engine, CrawlJournalType type, const char *url, size_t depth)
+{
+    CrawlEngineEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.depth = depth;
+    size_t url_len = strlen(url);
+    memcpy(entry.url, url, url_len);
+    size_t tail = engine->frontier_added % CRAWL_ENGINE_FRONTIER_SIZE;
+    if (!storage_file_seek(engine->frontier, tail * sizeof(entry), true) ||
+        storage_file_write(engine->frontier, &entry, sizeof(entry)) != sizeof(entry))
+    {
+        FURI_LOG_E(CRAWL_TAG, "Failed to write to the frontier");
+        return false;
+    }
+    if (!crawl_engine_journal(engine, type, depth, 0, url, url_len))
+    {
+        return false;
+    }
+    engine->frontier_added++;
+    engine->frontier_len++;
+    return true;
+}
+
+// Start a new crawl from the start URL
+static bool crawl_engine_start(CrawlEngine *engine, const char *start_url)
+{
+    engine->frontier = crawl_engine_open(engine, "frontier.bin", 0);
+    engine->hosts = crawl_engine_open(engine, "hosts.bin", CRAWL_ENGINE_HOST_SLOTS * 2 * sizeof(uint32_t));
+    engine->journal = crawl_engine_open(engine, "journal.bin", 0);
+    File *pages = crawl_engine_open(engine, "pages.txt", 0); // start with no saved pages
+    crawl_engine_close(&pages);
+    if (!engine->frontier || !engine->hosts || !engine->journal ||
+        !crawl_engine_journal(engine, CrawlJournalStart, CRAWL_ENGINE_JOURNAL_VERSION, 0, start_url, strlen(start_url)) ||
+        !crawl_engine_add(engine, start_url, 0))
+    {
+        return false;
+    }
+    crawl_engine_sync(engine);
+    return true;
+}
+
+// Rebuild the state of an unfinished crawl of the same start URL from its journal
+static bool crawl_engine_resume(CrawlEngine *engine, const char *start_url)
+{
+    engine->journal = crawl_engine_open_existing(engine, "journal.bin");
+    if (!engine->journal)
+    {
+        return false;
+    }
+    size_t position = 0;
+    CrawlJournalRecord record;
+    char url[CRAWL_ENGINE_URL_SIZE + 1];
+    if (!crawl_engine_journal_read(engine, &position, &record, url) ||
+        record.type != CrawlJournalStart ||
+        record.value != CRAWL_ENGINE_JOURNAL_VERSION ||
+        strcmp(url, start_url) != 0)
+    {
+        crawl_engine_close(&engine->journal);
+        return false;
+    }
+    engine->frontier = crawl_engine_open_existing(engine, "frontier.bin");
+    engine->hosts = crawl_engine_open(engine, "hosts.bin", CRAWL_ENGINE_HOST_SLOTS * 2 * sizeof(uint32_t));
+    if (!engine->frontier || !engine->hosts)
+    {
+        crawl_engine_close(&engine->journal);
+        crawl_engine_close(&engine->frontier);
+        crawl_engine_close(&engine->hosts);
+        return false;
+    }
+    crawl_engine_load_visited(engine);
+
+    // replay the journal; the host counters are rebuilt from scratch
+    size_t requeue_position = position;
+    size_t requeue_taken = 0;
+    size_t failed_since_requeue = 0;
+    while (crawl_engine_journal_read(engine, &position, &record, url))
+    {
+        if (record.type == CrawlJournalAdd)
+        {
+            uint32_t host_key;
+            size_t host_slot;
+            uint32_t host_count;
+            crawl_engine_host_find(engine, url, &host_key, &host_slot, &host_count);
+            if (host_slot != SIZE_MAX)
+            {
+                crawl_engine_table_write(engine->hosts, host_slot, host_key, host_count + 1);
+            }
+            crawl_bloom_add(engine->visited, url, record.length);
+            engine->frontier_added++;
+            engine->scheduled++;
+        }
+        else if (record.type == CrawlJournalRetry)
+        {
+            engine->frontier_added++;
+        }
+        else if (record.type == CrawlJournalDone)
+        {
+            engine->frontier_taken++;
+            engine->pages_offset = record.offset;
+            if (record.value)
+            {
+                engine->fetched++;
+            }
+            else
+            {
+                engine->failed++;
+                failed_since_requeue++;
+            }
+        }
+        else if (record.type == CrawlJournalRequeue)
+        {
+            requeue_position = position;
+            requeue_taken = engine->frontier_taken;
+            failed_since_requeue = 0;
+            engine->failed -= MIN(engine->failed, record.offset); // those pages were given another try
+        }
+    }
+    // drop a record torn by a reset so new records follow the last complete one
+    storage_file_seek(engine->journal, position, true);
+    storage_file_truncate(engine->journal);
+    engine->frontier_len = engine->frontier_added - engine->frontier_taken;
+    if (engine->frontier_len == 0 && failed_since_requeue == 0)
+    {
+        // the earlier crawl finished, so start over
+        crawl_engine_close(&engine->journal);
+        crawl_engine_close(&engine->frontier);
+        crawl_engine_close(&engine->hosts);
+        engine->frontier_added = 0;
+        engine->frontier_taken = 0;
+        engine->frontier_len = 0;
+        engine->scheduled = 0;
+        engine->fetched = 0;
+        engine->failed = 0;
+        engine->pages_offset = 0;
+        crawl_bloom_clear(engine->visited);
+        return false;
+    }
+
+    // give the pages that failed since the last resume another try
+    size_t end = position;
+    size_t taken = requeue_taken;
+    uint32_t retried = 0;
+    position = requeue_position;
+    while (position < end && crawl_engine_journal_read(engine, &position, &record, url))
+    {
+        if (record.type != CrawlJournalDone)
+        {
+            continue;
+        }
+        size_t index = taken++;
+        if (record.value || engine->frontier_added - index >= CRAWL_ENGINE_FRONTIER_SIZE ||
+            engine->frontier_len >= CRAWL_ENGINE_FRONTIER_SIZE)
+        {
+            continue; // fetched, or its entry was overwritten by newer URLs
+        }
+        CrawlEngineEntry entry;
+        if (storage_file_seek(engine->frontier, (index % CRAWL_ENGINE_FRONTIER_SIZE) * sizeof(entry), true) &&
+            storage_file_read(engine->frontier, &entry, sizeof(entry)) == sizeof(entry))
+        {
+            entry.url[CRAWL_ENGINE_URL_SIZE] = '\0';
+            if (crawl_engine_push(engine, CrawlJournalRetry, entry.url, entry.depth))
+            {
+                retried++;
+            }
+        }
+    }
+    crawl_engine_journal(engine, CrawlJournalRequeue, 0, retried, NULL, 0);
+    engine->failed -= MIN(engine->failed, retried);
+
+    // drop the output of a page that was cut off
+    File *pages = crawl_engine_open_existing(engine, "pages.txt");
+    if (pages)
+    {
+        storage_file_seek(pages, engine->pages_offset, true);
+        storage_file_truncate(pages);
+        crawl_engine_close(&pages);
+    }
+    crawl_engine_sync(engine);
+    engine->resumed = true;
+    FURI_LOG_I(CRAWL_TAG, "Resumed crawl: %u fetched, %u waiting, %lu retried", (unsigned int)engine->fetched, (unsigned int)engine->frontier_len, retried);
+    return true;
+}
+
+CrawlEngine *crawl_engine_alloc(const char *directory, const char *start_url, size_t max_depth, size_t max_per_host)
+{
+    CrawlEngine *engine = (CrawlEngine *)malloc(sizeof(CrawlEngine));
+    if (!engine)
+    {
+        FURI_LOG_E(CRAWL_TAG, "Failed to allocate crawl engine");
+        return NULL;
+    }
+    memset(engine, 0, sizeof(CrawlEngine));
+    snprintf(engine->directory, sizeof(engine->directory), "%s", directory);
+    engine->max_depth = max_depth;
+    engine->max_per_host = max_per_host;
+
+    engine->storage = furi_record_open(RECORD_STORAGE);
+    storage_common_mkdir(engine->storage, engine->directory);
+    engine->visited = crawl_bloom_alloc(CRAWL_ENGINE_VISITED_CAPACITY, CRAWL_ENGINE_VISITED_FALSE_POSITIVE_RATE);
+    // one writer for the links file of every page, so it outlives the connection fetching them
+    engine->links_writer = flipper_http_file_writer_alloc();
+    if (!engine->visited || !engine->links_writer ||
+        (!crawl_engine_resume(engine, start_url) && !crawl_engine_start(engine, start_url)))
+    {
+        crawl_engine_free(engine);
+        return NULL;
+    }
+    return engine;
+}
+
+void crawl_engine_free(CrawlEngine *engine)
+{
+    if (!engine)
+    {
+        return;
+    }
+    if (engine->links_open)
+    {
+        flipper_http_file_sink_close(&engine->links);
+    }
+    flipper_http_file_writer_free(engine->links_writer);
+    if (engine->visited)
+    {
+        crawl_engine_save_visited(engine);
+    }
+    // a page still pending is not journaled, so a resumed crawl fetches it again
+    crawl_engine_close(&engine->journal);
+    crawl_engine_close(&engine->frontier);
+    crawl_bloom_free(engine->visited);
+    crawl_engine_close(&engine->hosts);
+    furi_record_close(RECORD_STORAGE);
+    free(engine);
+}
+
+bool crawl_engine_add(CrawlEngine *engine, const char *url, size_t depth)
+{
+    size_t url_len = strlen(url);
+    if (depth > engine->max_depth || url_len > CRAWL_ENGINE_URL_SIZE || engine->frontier_len >= CRAWL_ENGINE_FRONTIER_SIZE)
+    {
+        engine->skipped++;
+        return false;
+    }
+
+    // a false positive makes a new URL look visited, which only skips that URL
+    if (crawl_bloom_contains(engine->visited, url, url_len))
+    {
+        engine->skipped++;
+        return false;
+    }
+
+    uint32_t host_key;
+    size_t host_slot;
+    uint32_t host_count;
+    crawl_engine_host_find(engine, url, &host_key, &host_slot, &host_count);
+    if (host_slot == SIZE_MAX || host_count >= engine->max_per_host)
+    {
+        engine->skipped++;
+        return false;
+    }
+
+    if (!crawl_engine_push(engine, CrawlJournalAdd, url, depth))
+    {
+        return false;
+    }
+    crawl_bloom_add(engine->visited, url, url_len);
+    crawl_engine_table_write(engine->hosts, host_slot, host_key, host_count + 1);
+    engine->scheduled++;
+    return true;
+}
+
+bool crawl_engine_next(CrawlEngine *engine)
+{
+    if (engine->page_pending)
+    {
+        // the previous page never finished
+        crawl_engine_page_done(engine, NULL);
+    }
+    if (engine->frontier_len == 0)
+    {
+        return false;
+    }
+    size_t head = engine->frontier_taken % CRAWL_ENGINE_FRONTIER_SIZE;
+    if (!storage_file_seek(engine->frontier, head * sizeof(CrawlEngineEntry), true) ||
+        storage_file_read(engine->frontier, &engine->current, sizeof(CrawlEngineEntry)) != sizeof(CrawlEngineEntry))
+    {
+        FURI_LOG_E(CRAWL_TAG, "Failed to read from the frontier");
+        return false;
+    }
+    engine->current.url[CRAWL_ENGINE_URL_SIZE] = '\0';
+    engine->frontier_taken++;
+    engine->frontier_len--;
+    engine->page_pending = true;
+    return true;
+}
+
+bool crawl_engine_page_start(CrawlEngine *engine)
+{
+    char path[96];
+    snprintf(path, sizeof(path), "%s/links.txt", engine->directory);
+    engine->links_open = flipper_http_file_sink_open(&engine->links, engine->links_writer, path);
+    return engine->links_open;
+}
+
+void crawl_engine_link_callback(const char *href, void *context)
+{
+    CrawlEngine *engine = (CrawlEngine *)context;
+    if (!engine->links_open)
+    {
+        return;
+    }
+    flipper_http_file_sink_write(&engine->links, href, strlen(href));
+    flipper_http_file_sink_write(&engine->links, "\n", 1);
+}
+
+// Check if a resolved URL names a file that is not a page
+static bool crawl_engine_is_skipped_file(const char *url)
+{
+    size_t path_end = strcspn(url, "?");
+    for (size_t e = 0; e < COUNT_OF(crawl_engine_skipped_extensions); e++)
+    {
+        const char *extension = crawl_engine_skipped_extensions[e];
+        size_t extension_len = strlen(extension);
+        if (path_end <= extension_len)
+        {
+            continue;
+        }
+        size_t i = 0;
+        while (i < extension_len && tolower((unsigned char)url[path_end - extension_len + i]) == extension[i])
+        {
+            i++;
+        }
+        if (i == extension_len)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t crawl_engine_page_end(CrawlEngine *engine)
+{
+    if (!engine->links_open)
+    {
+        return 0;
+    }
+    flipper_http_file_sink_close(&engine->links);
+    engine->links_open = false;
+    if ((size_t)engine->current.depth + 1 > engine->max_depth)
+    {
+        return 0; // the links of the deepest pages are never followed
+    }
+
+    char path[96];
+    snprintf(path, sizeof(path), "%s/links.txt", engine->directory);
+    File *file = storage_file_alloc(engine->storage);
+    if (!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING))
+    {
+        FURI_LOG_E(CRAWL_TAG, "Failed to open links file: %s", path);
+        storage_file_free(file);
+        return 0;
+    }
+
+    size_t added = 0;
+    char href[CRAWL_ENGINE_URL_SIZE + 1];
+    size_t href_len = 0;
+    bool href_overflow = false;
+    char url[CRAWL_ENGINE_URL_SIZE + 1];
+    uint8_t buffer[64];
+    size_t buffer_len;
+    while ((buffer_len = storage_file_read(file, buffer, sizeof(buffer))) > 0)
+    {
+        for (size_t i = 0; i < buffer_len; i++)
+        {
+            if (buffer[i] != '\n')
+            {
+                if (href_len < CRAWL_ENGINE_URL_SIZE)
+                {
+                    href[href_len++] = buffer[i];
+                }
+                else
+                {
+                    href_overflow = true;
+                }
+                continue;
+            }
+            href[href_len] = '\0';
+            href_len = 0;
+            if (href_overflow)
+            {
+                href_overflow = false;
+                engine->skipped++;
+                continue;
+            }
+            if (!crawl_engine_resolve(engine->current.url, href, url, sizeof(url)) || crawl_engine_is_skipped_file(url))
+            {
+                engine->skipped++;
+                continue;
+            }
+            if (crawl_engine_add(engine, url, engine->current.depth + 1))
+            {
+                added++;
+            }
+        }
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+    if (added > 0)
+    {
+        crawl_engine_sync(engine);
+        crawl_engine_save_visited(engine);
+    }
+    return added;
+}
+
+bool crawl_engine_page_done(CrawlEngine *engine, const char *text)
+{
+    if (!engine->page_pending)
+    {
+        return false;
+    }
+    engine->page_pending = false;
+
+    bool saved = false;
+    if (text)
+    {
+        // write from the end of the last finished page, replacing anything a failed write left behind
+        char path[96];
+        snprintf(path, sizeof(path), "%s/pages.txt", engine->directory);
+        File *file = storage_file_alloc(engine->storage);
+        if (storage_file_open(file, path, FSAM_WRITE, FSOM_OPEN_ALWAYS))
+        {
+            size_t url_len = strlen(engine->current.url);
+            size_t text_len = strlen(text);
+            saved = storage_file_seek(file, engine->pages_offset, true) &&
+                    storage_file_truncate(file) &&
+                    storage_file_write(file, engine->current.url, url_len) == url_len &&
+                    storage_file_write(file, "\n", 1) == 1 &&
+                    storage_file_write(file, text, text_len) == text_len &&
+                    storage_file_write(file, "\n\n", 2) == 2;
+            if (saved)
+            {
+                engine->pages_offset += url_len + text_len + 3;
+            }
+            storage_file_close(file);
+        }
+        else
+        {
+            FURI_LOG_E(CRAWL_TAG, "Failed to open pages file: %s", path);
+        }
+        storage_file_free(file);
+    }
+    if (saved)
+    {
+        engine->fetched++;
+    }
+    else
+    {
+        engine->failed++;
+    }
+
+    // checkpoint: a resumed crawl continues after this page
+    storage_file_sync(engine->frontier);
+    crawl_engine_journal(engine, CrawlJournalDone, saved, engine->pages_offset, NULL, 0);
+    storage_file_sync(engine->journal);
+    return saved;
+}
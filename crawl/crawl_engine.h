@@ -0,0 +1,171 @@
+#pragma once
+#include <furi.h>
+#include <storage/storage.h>
+#include <flipper_http/flipper_http.h>
+#include <crawl/crawl_bloom.h>
+
+#define CRAWL_ENGINE_URL_SIZE 128                      // Longest URL the crawler schedules
+#define CRAWL_ENGINE_FRONTIER_SIZE 256                 // Most URLs waiting to be fetched
+#define CRAWL_ENGINE_VISITED_CAPACITY 4096             // URLs the visited set is sized for
+#define CRAWL_ENGINE_VISITED_FALSE_POSITIVE_RATE 0.01f // Chance a new URL is taken as visited once the set is full
+#define CRAWL_ENGINE_HOST_SLOTS 256                    // Slots of the per-host counters, the most hosts a crawl can reach
+#define CRAWL_ENGINE_PROBE_LIMIT 32                    // Slots checked before the host counters are treated as full
+#define CRAWL_ENGINE_MAX_DEPTH 2                       // Links followed away from the start page
+#define CRAWL_ENGINE_MAX_PER_HOST 32                   // URLs scheduled for a single host
+#define CRAWL_ENGINE_MAX_PAGES 64                      // Pages fetched by a single crawl
+#define CRAWL_ENGINE_JOURNAL_VERSION 1                 // Version of the journal format
+
+// A URL waiting in the frontier, stored as a fixed-size record on the SD card
+typedef struct
+{
+    uint8_t depth;                         // Links followed from the start page to reach the URL
+    char url[CRAWL_ENGINE_URL_SIZE + 1];   // The normalized URL
+} CrawlEngineEntry;
+
+// Kinds of records in the crawl journal
+typedef enum
+{
+    CrawlJournalStart = 1, // The start URL of the crawl, always the first record
+    CrawlJournalAdd,       // A URL was added to the frontier
+    CrawlJournalRetry,     // A URL that failed was added to the frontier again by a resume
+    CrawlJournalDone,      // The oldest URL taken from the frontier was fetched or failed
+    CrawlJournalRequeue,   // A resume added the URLs that failed before it to the frontier again
+} CrawlJournalType;
+
+// Header of a journal record, followed by the URL for Start, Add and Retry records
+typedef struct
+{
+    uint8_t type;    // CrawlJournalType
+    uint8_t value;   // Version for Start, depth for Add and Retry, 1 if the page was saved for Done
+    uint16_t length; // Length of the URL that follows
+    uint32_t offset; // Size of pages.txt after the page for Done, URLs retried for Requeue
+} CrawlJournalRecord;
+
+// Breadth-first crawl state; the frontier and host counters live on the SD card, the
+// fixed-size visited set is saved next to them after every page, and every change is
+// appended to journal.bin so an interrupted crawl can be resumed
+typedef struct
+{
+    Storage *storage;
+    File *frontier;        // Ring buffer of CRAWL_ENGINE_FRONTIER_SIZE entries
+    CrawlBloom *visited;   // URLs already scheduled, saved to visited.bin
+    File *hosts;           // Open-addressed map of host hashes to scheduled URL counts
+    File *journal;         // Append-only log of the crawl, replayed to resume it
+    size_t frontier_added; // Entries ever added to the frontier; the next one goes to this index
+    size_t frontier_taken; // Entries ever taken from the frontier; the next one comes from this index
+    size_t frontier_len;   // Number of entries waiting
+    char directory[64];    // Directory holding the crawl files
+
+    size_t max_depth;    // Deepest link followed
+    size_t max_per_host; // Most URLs scheduled per host
+
+    CrawlEngineEntry current;            // The page being fetched
+    FlipperHTTPFileSink links;           // Links found on the current page, spilled to the SD card while it downloads
+    FlipperHTTPFileWriter *links_writer; // Writer thread of the links file, reused for every page
+    bool links_open;                     // Indicates if the links file is open
+
+    bool page_pending;   // Indicates if the current page was taken but not finished
+    size_t pages_offset; // Size of pages.txt after the last finished page
+
+    size_t scheduled; // URLs added to the frontier
+    size_t skipped;   // Links dropped as duplicates, over a limit, or not crawlable
+    size_t fetched;   // Pages saved
+    size_t failed;    // Pages that could not be fetched or saved
+    bool resumed;     // Indicates if the crawl continued an interrupted one
+} CrawlEngine;
+
+/*
+ * @brief Resolve a link found on a page into an absolute, normalized http(s) URL.
+ *
+ * Entities are decoded, the fragment is dropped, relative paths and dot segments are
+ * resolved, the scheme and host are lowercased and default ports are removed.
+ *
+ * @param base The URL of the page the link was found on, or NULL if href must be absolute.
+ * @param href The link as written in the page.
+ * @param out The buffer for the resolved URL.
+ * @param out_size The size of the buffer.
+ * @return true if the link is a crawlable URL that fits in the buffer, false otherwise.
+ */
+bool crawl_engine_resolve(const char *base, const char *href, char *out, size_t out_size);
+
+/*
+ * @brief Resume the unfinished crawl of the same start URL in the directory, or start a new one.
+ *
+ * A crawl is resumed by replaying its journal: pages already finished are not fetched again,
+ * pages that failed are scheduled again, and output of a page that was cut off is dropped
+ * from pages.txt. Otherwise the files of any previous crawl are replaced and the start URL
+ * is scheduled.
+ *
+ * @param directory The directory for the crawl files; it is created if needed.
+ * @param start_url The absolute, normalized URL the crawl starts from.
+ * @param max_depth The deepest link to follow from the start page.
+ * @param max_per_host The most URLs to schedule per host.
+ * @return The crawl engine, or NULL on failure.
+ */
+CrawlEngine *crawl_engine_alloc(const char *directory, const char *start_url, size_t max_depth, size_t max_per_host);
+
+/*
+ * @brief Free a crawl engine and close its files.
+ * @param engine The crawl engine to free.
+ */
+void crawl_engine_free(CrawlEngine *engine);
+
+/*
+ * @brief Schedule a URL unless it was already scheduled or is over the depth or host limit.
+ * @param engine The crawl engine.
+ * @param url The absolute, normalized URL.
+ * @param depth The links followed from the start page to reach the URL.
+ * @return true if the URL was added to the frontier, false otherwise.
+ */
+bool crawl_engine_add(CrawlEngine *engine, const char *url, size_t depth);
+
+/*
+ * @brief Take the next URL from the frontier into engine->current.
+ *
+ * A page taken before without crawl_engine_page_done is recorded as failed first.
+ *
+ * @param engine The crawl engine.
+ * @return true if there was a URL to fetch, false if the frontier is empty.
+ */
+bool crawl_engine_next(CrawlEngine *engine);
+
+/*
+ * @brief Prepare to collect the links of the current page.
+ * @param engine The crawl engine.
+ * @return true if links can be collected, false otherwise.
+ */
+bool crawl_engine_page_start(CrawlEngine *engine);
+
+/*
+ * @brief Collect a link of the current page. Matches HTMLFuriStreamLinkCallback.
+ *
+ * Runs on the FlipperHTTP worker for every link as the page streams in, so it only copies the link
+ * into the write-behind buffer of links.txt; the writer thread saves it.
+ *
+ * @param href The link as written in the page.
+ * @param context The CrawlEngine.
+ */
+void crawl_engine_link_callback(const char *href, void *context);
+
+/*
+ * @brief Schedule the links collected from the current page.
+ *
+ * Reads links.txt back with about 0.6 KB of buffers on the stack and writes the frontier, so call it
+ * from the app's own thread once the response has ended, not from the worker or a timer callback.
+ *
+ * @param engine The crawl engine.
+ * @return The number of links added to the frontier.
+ */
+size_t crawl_engine_page_end(CrawlEngine *engine);
+
+/*
+ * @brief Finish the current page and checkpoint the crawl.
+ *
+ * The text is appended to pages.txt in the crawl directory, and the page is recorded in the
+ * journal so a resumed crawl continues after it.
+ *
+ * @param engine The crawl engine.
+ * @param text The text extracted from the page, or NULL if the page failed.
+ * @return true if the text was saved, false otherwise.
+ */
+bool crawl_engine_page_done(CrawlEngine *engine, const char *text);
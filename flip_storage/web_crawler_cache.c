@@ -0,0 +1,214 @@
+#include <flip_storage/web_crawler_cache.h>
+#include <datetime/datetime.h>
+#include <ctype.h>
+
+// Function to hash a URL into the name of its cache entry (32-bit FNV-1a)
+static uint32_t cache_hash(const char *url)
+{
+    uint32_t hash = 2166136261u;
+    for (const char *c = url; *c != '\0'; c++)
+    {
+        hash ^= (uint8_t)*c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Function to get the path of the cache entry of a URL
+static void cache_entry_path(const char *url, char *path, size_t path_size)
+{
+    snprintf(path, path_size, CACHE_PATH "/%08lx.bin", (unsigned long)cache_hash(url));
+}
+
+// Function to check if the request headers already name a header, ignoring case
+static bool cache_has_header(const char *headers, const char *name)
+{
+    size_t name_len = strlen(name);
+    for (const char *c = headers; *c != '\0'; c++)
+    {
+        if (strncasecmp(c, name, name_len) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Function to get the size of a file, or false if it cannot be opened
+static bool cache_file_size(Storage *storage, const char *file_path, uint32_t *size)
+{
+    File *file = storage_file_alloc(storage);
+    bool success = storage_file_open(file, file_path, FSAM_READ, FSOM_OPEN_EXISTING);
+    if (success)
+    {
+        *size = storage_file_size(file);
+        storage_file_close(file);
+    }
+    storage_file_free(file);
+    return success;
+}
+
+// Function to read the entry of a URL, checking that it belongs to the URL and the response path
+static bool cache_load(Storage *storage, const char *url, const char *file_path, CacheEntryHeader *header)
+{
+    char path[128];
+    cache_entry_path(url, path, sizeof(path));
+    File *file = storage_file_alloc(storage);
+    if (!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING))
+    {
+        storage_file_free(file);
+        return false;
+    }
+    size_t url_len = strlen(url);
+    size_t path_len = strlen(file_path);
+    char stored[256];
+    bool success = storage_file_read(file, header, sizeof(CacheEntryHeader)) == sizeof(CacheEntryHeader) &&
+                   header->magic == CACHE_MAGIC &&
+                   header->version == CACHE_VERSION &&
+                   header->url_len == url_len &&
+                   header->path_len == path_len &&
+                   url_len < sizeof(stored) &&
+                   path_len < sizeof(stored) &&
+                   storage_file_read(file, stored, url_len) == url_len &&
+                   memcmp(stored, url, url_len) == 0 &&
+                   storage_file_read(file, stored, path_len) == path_len &&
+                   memcmp(stored, file_path, path_len) == 0;
+    storage_file_close(file);
+    storage_file_free(file);
+    return success;
+}
+
+bool cache_if_modified_since(const char *url, const char *file_path, const char *headers, char *out, size_t out_size)
+{
+    if (!url || !file_path || !headers || !out)
+    {
+        FURI_LOG_E(TAG, "Invalid arguments provided to cache_if_modified_since.");
+        return false;
+    }
+
+    // the request's own conditions win
+    if (cache_has_header(headers, "If-Modified-Since") || cache_has_header(headers, "If-None-Match"))
+    {
+        return false;
+    }
+
+    // a 304 is only useful while the last response is still on the SD card as it was saved
+    Storage *storage = furi_record_open(RECORD_STORAGE);
+    CacheEntryHeader header;
+    uint32_t size;
+    bool cached = cache_load(storage, url, file_path, &header) &&
+                  cache_file_size(storage, file_path, &size) &&
+                  size == header.size;
+    furi_record_close(RECORD_STORAGE);
+    if (!cached)
+    {
+        return false;
+    }
+
+    // the board does not pass response headers on, so the server's ETag and Last-Modified are never seen;
+    // the download time stands in for Last-Modified, moved back so an RTC ahead of GMT cannot hide a change
+    uint32_t timestamp = header.fetched > CACHE_CLOCK_SKEW ? header.fetched - CACHE_CLOCK_SKEW : 0;
+    DateTime datetime;
+    datetime_timestamp_to_datetime(timestamp, &datetime);
+    static const char *days[] = {"Thu", "Fri", "Sat", "Sun", "Mon", "Tue", "Wed"}; // 1 January 1970 was a Thursday
+    static const char *months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    char if_modified_since[CACHE_HEADER_SIZE];
+    snprintf(
+        if_modified_since,
+        sizeof(if_modified_since),
+        "\"If-Modified-Since\": \"%s, %02u %s %04u %02u:%02u:%02u GMT\"",
+        days[(timestamp / 86400) % 7],
+        datetime.day,
+        months[(datetime.month - 1) % 12],
+        datetime.year,
+        datetime.hour,
+        datetime.minute,
+        datetime.second);
+
+    // add the header to the JSON object of the request headers
+    const char *open = strchr(headers, '{');
+    const char *close = strrchr(headers, '}');
+    int written;
+    if (!open)
+    {
+        if (headers[strspn(headers, " \t\r\n")] != '\0')
+        {
+            return false; // not a JSON object
+        }
+        written = snprintf(out, out_size, "{%s}", if_modified_since);
+    }
+    else
+    {
+        if (!close || close < open)
+        {
+            return false;
+        }
+        const char *body = open + 1 + strspn(open + 1, " \t\r\n");
+        written = snprintf(
+            out, out_size, "%.*s%s%s}", (int)(close - headers), headers, body == close ? "" : ", ", if_modified_since);
+    }
+    return written > 0 && (size_t)written < out_size;
+}
+
+bool cache_store(const char *url, const char *file_path)
+{
+    if (!url || !file_path)
+    {
+        FURI_LOG_E(TAG, "Invalid arguments provided to cache_store.");
+        return false;
+    }
+    Storage *storage = furi_record_open(RECORD_STORAGE);
+    CacheEntryHeader header = {
+        .magic = CACHE_MAGIC,
+        .version = CACHE_VERSION,
+        .url_len = strlen(url),
+        .path_len = strlen(file_path),
+        .reserved = 0,
+        .fetched = furi_hal_rtc_get_timestamp(),
+        .size = 0,
+    };
+    if (!cache_file_size(storage, file_path, &header.size) || header.size == 0)
+    {
+        furi_record_close(RECORD_STORAGE);
+        return false;
+    }
+
+    storage_common_mkdir(storage, CACHE_PATH);
+    char path[128];
+    cache_entry_path(url, path, sizeof(path));
+    File *file = storage_file_alloc(storage);
+    bool success = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                   storage_file_write(file, &header, sizeof(header)) == sizeof(header) &&
+                   storage_file_write(file, url, header.url_len) == header.url_len &&
+                   storage_file_write(file, file_path, header.path_len) == header.path_len;
+    if (!success)
+    {
+        FURI_LOG_E(TAG, "Failed to write cache entry: %s", path);
+    }
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return success;
+}
+
+bool cache_not_modified(const char *response)
+{
+    if (!response || strncmp(response, "[ERROR]", 7) != 0)
+    {
+        return false;
+    }
+    // the board only sends [GET/SUCCESS] for a body, so it reports the empty 304 as an error with its status code;
+    // its other errors, including "request failed or returned empty data.", are failures
+    size_t name_len = strlen("status code");
+    for (const char *c = response + 7; *c != '\0'; c++)
+    {
+        if (strncasecmp(c, "status code", name_len) != 0)
+        {
+            continue;
+        }
+        const char *code = c + name_len;
+        code += strspn(code, ": ");
+        return strncmp(code, "304", 3) == 0 && !isdigit((unsigned char)code[3]);
+    }
+    return false;
+}
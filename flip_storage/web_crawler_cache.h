@@ -0,0 +1,31 @@
+#pragma once
+#include <flip_storage/web_crawler_storage.h>
+
+// Download-time cache: the board never passes response headers on, so no ETag or Last-Modified is stored.
+// A repeated GET asks If-Modified-Since the RTC time of the last download, moved back by CACHE_CLOCK_SKEW.
+
+#define CACHE_MAGIC 0x48435743          // "CWCH", marks a cache entry
+#define CACHE_VERSION 1                 // Version of the cache entry format
+#define CACHE_CLOCK_SKEW (14 * 60 * 60) // Seconds If-Modified-Since is moved back to cover the RTC keeping local time
+#define CACHE_HEADER_SIZE 64            // Room for the If-Modified-Since header added to a request
+
+// Cache entry written to CACHE_PATH, followed by the URL and the path of the saved response
+typedef struct
+{
+    uint32_t magic;    // CACHE_MAGIC
+    uint16_t version;  // CACHE_VERSION
+    uint16_t url_len;  // Length of the URL that follows
+    uint16_t path_len; // Length of the response path that follows the URL
+    uint16_t reserved; // Always 0
+    uint32_t fetched;  // RTC timestamp of the download
+    uint32_t size;     // Size of the saved response
+} CacheEntryHeader;
+
+// Function to add If-Modified-Since, from the time of the last download, to the headers of a GET whose last response is still saved, unchanged, at file_path
+bool cache_if_modified_since(const char *url, const char *file_path, const char *headers, char *out, size_t out_size);
+
+// Function to remember the response of a GET saved at file_path, so the next GET of url can be conditional
+bool cache_store(const char *url, const char *file_path);
+
+// Function to check if the board answered a conditional GET with "not modified", i.e. an [ERROR] line with "status code: 304"
+bool cache_not_modified(const char *response);
@@ -468,3 +468,129 @@ bool load_char(
 
     return strlen(value) > 0;
 }
+
+// Read the next URL of an open crawl list, starting at *offset
+static bool crawl_list_next(File *file, size_t *offset, char *url, size_t url_size, bool *truncated)
+{
+    if (!storage_file_seek(file, *offset, true))
+    {
+        return false;
+    }
+
+    uint8_t buffer[64];
+    size_t buffer_len = 0;
+    size_t buffer_pos = 0;
+    size_t url_len = 0;
+    bool comment = false;
+    *truncated = false;
+    while (true)
+    {
+        if (buffer_pos == buffer_len)
+        {
+            buffer_len = storage_file_read(file, buffer, sizeof(buffer));
+            buffer_pos = 0;
+        }
+        bool end_of_file = buffer_len == 0;
+        char c = end_of_file ? '\n' : (char)buffer[buffer_pos++];
+        if (!end_of_file)
+        {
+            (*offset)++;
+        }
+
+        if (c == '\n' || c == '\r')
+        {
+            // drop trailing whitespace
+            while (url_len > 0 && (url[url_len - 1] == ' ' || url[url_len - 1] == '\t'))
+            {
+                url_len--;
+            }
+            if (url_len > 0)
+            {
+                url[url_len] = '\0';
+                return true;
+            }
+            if (end_of_file)
+            {
+                return false;
+            }
+            // blank or comment line
+            comment = false;
+            *truncated = false;
+            continue;
+        }
+        if (comment || (url_len == 0 && (c == ' ' || c == '\t')))
+        {
+            continue;
+        }
+        if (url_len == 0 && c == '#')
+        {
+            comment = true;
+            continue;
+        }
+        if (url_len + 1 < url_size)
+        {
+            url[url_len++] = c;
+        }
+        else
+        {
+            *truncated = true;
+        }
+    }
+}
+
+size_t crawl_list_count()
+{
+    Storage *storage = furi_record_open(RECORD_STORAGE);
+    File *file = storage_file_alloc(storage);
+    if (!storage_file_open(file, CRAWL_LIST_PATH, FSAM_READ, FSOM_OPEN_EXISTING))
+    {
+        storage_file_free(file);
+        furi_record_close(RECORD_STORAGE);
+        return 0; // no list means nothing to crawl
+    }
+
+    char url[128];
+    size_t offset = 0;
+    size_t count = 0;
+    bool truncated;
+    while (crawl_list_next(file, &offset, url, sizeof(url), &truncated))
+    {
+        count++;
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return count;
+}
+
+bool crawl_list_read(size_t *offset, char *url, size_t url_size)
+{
+    if (!offset || !url || url_size == 0)
+    {
+        return false;
+    }
+    Storage *storage = furi_record_open(RECORD_STORAGE);
+    File *file = storage_file_alloc(storage);
+    if (!storage_file_open(file, CRAWL_LIST_PATH, FSAM_READ, FSOM_OPEN_EXISTING))
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to open crawl list: %s", CRAWL_LIST_PATH);
+        storage_file_free(file);
+        furi_record_close(RECORD_STORAGE);
+        return false;
+    }
+
+    bool truncated = false;
+    bool found = crawl_list_next(file, offset, url, url_size, &truncated);
+    if (found && truncated)
+    {
+        // the offset still moved past the line so the next URL can be read
+        FURI_LOG_E(HTTP_TAG, "URL too long: %s...", url);
+        found = false;
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return found;
+}
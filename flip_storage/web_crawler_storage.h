@@ -5,6 +5,10 @@
 
 #define SETTINGS_PATH STORAGE_EXT_PATH_PREFIX "/apps_data/" http_tag "/settings.bin"
 #define RECEIVED_DATA_PATH STORAGE_EXT_PATH_PREFIX "/apps_data/" http_tag "/" // add the file name to the end (e.g. "received_data.txt")
+#define CRAWL_LIST_PATH STORAGE_EXT_PATH_PREFIX "/apps_data/" http_tag "/urls.txt" // one URL per line
+#define CRAWL_DATA_PATH STORAGE_EXT_PATH_PREFIX "/apps_data/" http_tag "/crawl"    // where a batch crawl saves each response
+#define CRAWL_SITE_PATH STORAGE_EXT_PATH_PREFIX "/apps_data/" http_tag "/site"     // where a site crawl keeps its frontier and pages
+#define CACHE_PATH STORAGE_EXT_PATH_PREFIX "/apps_data/" http_tag "/cache"         // where the validators of saved GET responses are kept
 
 // Function to save settings: path, SSID, and password
 void save_settings(
@@ -47,3 +51,9 @@ bool load_char(
     const char *path_name,
     char *value,
     size_t value_size);
+
+// Function to count the URLs in the crawl list (blank lines and lines starting with '#' are skipped)
+size_t crawl_list_count();
+
+// Function to read the next URL of the crawl list, starting at *offset (advanced past the line that was read)
+bool crawl_list_read(size_t *offset, char *url, size_t url_size);
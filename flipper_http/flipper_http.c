@@ -65,6 +65,429 @@ bool flipper_http_append_to_file(
     return true;
 }
 
+// Writer thread of a file writer, saves full buffers in the order they were filled
+static int32_t flipper_http_file_writer_thread(void *context)
+{
+    FlipperHTTPFileWriter *writer = (FlipperHTTPFileWriter *)context;
+    FlipperHTTPFileSinkBlock block;
+    while (furi_message_queue_get(writer->full, &block, FuriWaitForever) == FuriStatusOk && block.sink)
+    {
+        FlipperHTTPFileSink *sink = block.sink;
+        if (!block.data)
+        {
+            // Everything the closing sink queued before this block is saved
+            furi_thread_flags_set(sink->closer, FILE_SINK_SYNCED);
+            continue;
+        }
+        if (!sink->failed && storage_file_write(sink->file, block.data, block.size) != block.size)
+        {
+            FURI_LOG_E(HTTP_TAG, "Failed to append data to file");
+            sink->failed = true;
+        }
+        furi_message_queue_put(writer->empty, &block.data, FuriWaitForever);
+    }
+    return 0;
+}
+
+// Function to allocate a file writer
+FlipperHTTPFileWriter *flipper_http_file_writer_alloc(void)
+{
+    FlipperHTTPFileWriter *writer = (FlipperHTTPFileWriter *)malloc(sizeof(FlipperHTTPFileWriter));
+    if (!writer)
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to allocate file writer");
+        return NULL;
+    }
+    memset(writer, 0, sizeof(FlipperHTTPFileWriter));
+
+    writer->buffers = (uint8_t *)malloc(FILE_SINK_BUFFER_COUNT * FILE_SINK_BUFFER_SIZE);
+    // Room for every buffer plus the sync block of each sink and the stop block
+    writer->full = furi_message_queue_alloc(FILE_SINK_BUFFER_COUNT * 2 + 1, sizeof(FlipperHTTPFileSinkBlock));
+    writer->empty = furi_message_queue_alloc(FILE_SINK_BUFFER_COUNT, sizeof(uint8_t *));
+    if (!writer->buffers || !writer->full || !writer->empty)
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to allocate file writer buffers");
+        flipper_http_file_writer_free(writer);
+        return NULL;
+    }
+    for (size_t i = 0; i < FILE_SINK_BUFFER_COUNT; i++)
+    {
+        uint8_t *buffer = &writer->buffers[i * FILE_SINK_BUFFER_SIZE];
+        furi_message_queue_put(writer->empty, &buffer, 0);
+    }
+
+    writer->thread = furi_thread_alloc_ex("FlipperHTTP_Writer", 1024, flipper_http_file_writer_thread, writer);
+    furi_thread_start(writer->thread);
+    return writer;
+}
+
+// Function to free a file writer
+void flipper_http_file_writer_free(FlipperHTTPFileWriter *writer)
+{
+    if (!writer)
+    {
+        return;
+    }
+    if (writer->thread)
+    {
+        // The writer saves everything queued before the stop block, then exits
+        FlipperHTTPFileSinkBlock stop = {
+            .sink = NULL,
+            .data = NULL,
+            .size = 0,
+        };
+        furi_message_queue_put(writer->full, &stop, FuriWaitForever);
+        furi_thread_join(writer->thread);
+        furi_thread_free(writer->thread);
+    }
+    if (writer->full)
+    {
+        furi_message_queue_free(writer->full);
+    }
+    if (writer->empty)
+    {
+        furi_message_queue_free(writer->empty);
+    }
+    free(writer->buffers);
+    free(writer);
+}
+
+// Open the file sink, replacing any existing file at file_path
+bool flipper_http_file_sink_open(FlipperHTTPFileSink *sink, FlipperHTTPFileWriter *writer, const char *file_path)
+{
+    if (!sink || !writer || !file_path)
+    {
+        FURI_LOG_E(HTTP_TAG, "Invalid arguments provided to flipper_http_file_sink_open.");
+        return false;
+    }
+
+    // Close anything left over from a previous response
+    flipper_http_file_sink_close(sink);
+
+    sink->storage = furi_record_open(RECORD_STORAGE);
+    sink->file = storage_file_alloc(sink->storage);
+    if (!storage_file_open(sink->file, file_path, FSAM_WRITE, FSOM_CREATE_ALWAYS))
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to open file for writing: %s", file_path);
+        storage_file_free(sink->file);
+        furi_record_close(RECORD_STORAGE);
+        memset(sink, 0, sizeof(FlipperHTTPFileSink));
+        return false;
+    }
+
+    // A buffer is taken from the writer once there is data for it
+    sink->writer = writer;
+    sink->buffer = NULL;
+    sink->buffer_len = 0;
+    sink->failed = false;
+    return true;
+}
+
+// Hand the buffer being filled to the writer thread
+static void flipper_http_file_sink_flush(FlipperHTTPFileSink *sink)
+{
+    FlipperHTTPFileSinkBlock block = {
+        .sink = sink,
+        .data = sink->buffer,
+        .size = sink->buffer_len,
+    };
+    furi_message_queue_put(sink->writer->full, &block, FuriWaitForever);
+    sink->buffer = NULL;
+    sink->buffer_len = 0;
+}
+
+// Write data through the file sink's write-behind buffers
+bool flipper_http_file_sink_write(FlipperHTTPFileSink *sink, const void *data, size_t data_size)
+{
+    if (!sink || !sink->file)
+    {
+        FURI_LOG_E(HTTP_TAG, "File sink is not open.");
+        return false;
+    }
+    const uint8_t *bytes = (const uint8_t *)data;
+    while (data_size > 0)
+    {
+        if (!sink->buffer)
+        {
+            // Only waits if the writer is still saving every buffer
+            furi_message_queue_get(sink->writer->empty, &sink->buffer, FuriWaitForever);
+        }
+        size_t space = FILE_SINK_BUFFER_SIZE - sink->buffer_len;
+        size_t copy_len = data_size < space ? data_size : space;
+        memcpy(&sink->buffer[sink->buffer_len], bytes, copy_len);
+        sink->buffer_len += copy_len;
+        bytes += copy_len;
+        data_size -= copy_len;
+
+        if (sink->buffer_len >= FILE_SINK_BUFFER_SIZE)
+        {
+            flipper_http_file_sink_flush(sink);
+            if (sink->failed)
+            {
+                return false;
+            }
+        }
+    }
+    return !sink->failed;
+}
+
+// Flush the write-behind buffers and close the file sink
+bool flipper_http_file_sink_close(FlipperHTTPFileSink *sink)
+{
+    if (!sink || !sink->file)
+    {
+        return true;
+    }
+    if (sink->buffer)
+    {
+        flipper_http_file_sink_flush(sink);
+    }
+
+    // The writer sets FILE_SINK_SYNCED once it has saved everything queued before the sync block
+    sink->closer = furi_thread_get_current_id();
+    FlipperHTTPFileSinkBlock sync = {
+        .sink = sink,
+        .data = NULL,
+        .size = 0,
+    };
+    furi_message_queue_put(sink->writer->full, &sync, FuriWaitForever);
+    furi_thread_flags_wait(FILE_SINK_SYNCED, FuriFlagWaitAny, FuriWaitForever);
+
+    bool success = !sink->failed;
+    storage_file_close(sink->file);
+    storage_file_free(sink->file);
+    furi_record_close(RECORD_STORAGE);
+    memset(sink, 0, sizeof(FlipperHTTPFileSink));
+    return success;
+}
+
+// Built-in file sink, writes to fhttp->file_path
+static bool flipper_http_sink_file_open(void *context)
+{
+    FlipperHTTP *fhttp = (FlipperHTTP *)context;
+    return flipper_http_file_sink_open(&fhttp->file_sink, fhttp->file_writer, fhttp->file_path);
+}
+
+static bool flipper_http_sink_file_write(const uint8_t *data, size_t data_size, void *context)
+{
+    FlipperHTTP *fhttp = (FlipperHTTP *)context;
+    return flipper_http_file_sink_write(&fhttp->file_sink, data, data_size);
+}
+
+static bool flipper_http_sink_file_close(bool completed, void *context)
+{
+    UNUSED(completed);
+    FlipperHTTP *fhttp = (FlipperHTTP *)context;
+    return flipper_http_file_sink_close(&fhttp->file_sink);
+}
+
+// Built-in memory sink, keeps up to capacity bytes
+static bool flipper_http_sink_memory_open(void *context)
+{
+    FlipperHTTPMemorySink *memory = (FlipperHTTPMemorySink *)context;
+    memory->size = 0;
+    memory->truncated = false;
+    memory->data[0] = '\0';
+    return true;
+}
+
+static bool flipper_http_sink_memory_write(const uint8_t *data, size_t data_size, void *context)
+{
+    FlipperHTTPMemorySink *memory = (FlipperHTTPMemorySink *)context;
+    size_t space = memory->capacity - memory->size;
+    if (data_size > space)
+    {
+        memory->truncated = true;
+        data_size = space;
+    }
+    memcpy(&memory->data[memory->size], data, data_size);
+    memory->size += data_size;
+    memory->data[memory->size] = '\0';
+    return true;
+}
+
+FlipperHTTPMemorySink *flipper_http_memory_sink_alloc(size_t capacity)
+{
+    FlipperHTTPMemorySink *memory = (FlipperHTTPMemorySink *)malloc(sizeof(FlipperHTTPMemorySink));
+    if (!memory)
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to allocate memory sink.");
+        return NULL;
+    }
+    memory->data = (char *)malloc(capacity + 1);
+    if (!memory->data)
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to allocate memory sink buffer.");
+        free(memory);
+        return NULL;
+    }
+    memory->capacity = capacity;
+    flipper_http_sink_memory_open(memory);
+    return memory;
+}
+
+void flipper_http_memory_sink_free(FlipperHTTPMemorySink *memory)
+{
+    if (!memory)
+    {
+        return;
+    }
+    free(memory->data);
+    free(memory);
+}
+
+void flipper_http_set_sink(FlipperHTTP *fhttp, const FlipperHTTPSink *sink)
+{
+    if (!fhttp || !sink || !sink->write)
+    {
+        FURI_LOG_E(HTTP_TAG, "Invalid arguments provided to flipper_http_set_sink.");
+        return;
+    }
+    fhttp->sink = *sink;
+}
+
+void flipper_http_set_sink_file(FlipperHTTP *fhttp)
+{
+    FlipperHTTPSink sink = {
+        .open = flipper_http_sink_file_open,
+        .write = flipper_http_sink_file_write,
+        .close = flipper_http_sink_file_close,
+        .context = fhttp,
+    };
+    flipper_http_set_sink(fhttp, &sink);
+}
+
+void flipper_http_set_sink_memory(FlipperHTTP *fhttp, FlipperHTTPMemorySink *memory)
+{
+    if (!memory)
+    {
+        FURI_LOG_E(HTTP_TAG, "Invalid arguments provided to flipper_http_set_sink_memory.");
+        return;
+    }
+    FlipperHTTPSink sink = {
+        .open = flipper_http_sink_memory_open,
+        .write = flipper_http_sink_memory_write,
+        .close = NULL,
+        .context = memory,
+    };
+    flipper_http_set_sink(fhttp, &sink);
+}
+
+void flipper_http_set_sink_parser(FlipperHTTP *fhttp, FlipperHTTP_SinkWrite parse, void *context)
+{
+    FlipperHTTPSink sink = {
+        .open = NULL,
+        .write = parse,
+        .close = NULL,
+        .context = context,
+    };
+    flipper_http_set_sink(fhttp, &sink);
+}
+
+// Function to wake everything waiting on the current exchange
+static void flipper_http_notify_complete(FlipperHTTP *fhttp)
+{
+    furi_event_flag_set(fhttp->events, FlipperHTTPEvtComplete);
+    if (fhttp->complete_callback)
+    {
+        fhttp->complete_callback(fhttp->complete_context);
+    }
+}
+
+void flipper_http_set_complete_callback(FlipperHTTP *fhttp, FlipperHTTP_CompleteCallback callback, void *context)
+{
+    fhttp->complete_callback = callback;
+    fhttp->complete_context = context;
+}
+
+// Start passing the response body to the sink
+static void flipper_http_sink_begin(FlipperHTTP *fhttp)
+{
+    fhttp->bytes_tail_len = 0;
+    if (fhttp->compressed)
+    {
+        heatshrink_stream_reset(&fhttp->inflate);
+    }
+    if (!fhttp->save_received_data && !fhttp->save_bytes)
+    {
+        return;
+    }
+    if (fhttp->sink.open && !fhttp->sink.open(fhttp->sink.context))
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to open response sink.");
+        fhttp->save_received_data = false;
+        fhttp->save_bytes = false;
+        return;
+    }
+    fhttp->sink_open = true;
+}
+
+// Pass part of the response body to the sink
+static bool flipper_http_sink_write(FlipperHTTP *fhttp, const void *data, size_t data_size)
+{
+    if (!fhttp->sink_open || data_size == 0)
+    {
+        return true;
+    }
+    return fhttp->sink.write((const uint8_t *)data, data_size, fhttp->sink.context);
+}
+
+// Pass raw bytes to the sink, holding back the last BYTES_TAIL_SIZE so the end marker never reaches it
+static bool flipper_http_sink_write_bytes(FlipperHTTP *fhttp, const uint8_t *data, size_t data_size)
+{
+    size_t total = fhttp->bytes_tail_len + data_size;
+    if (total <= BYTES_TAIL_SIZE)
+    {
+        memcpy(&fhttp->bytes_tail[fhttp->bytes_tail_len], data, data_size);
+        fhttp->bytes_tail_len = total;
+        return true;
+    }
+
+    // Everything except the newest BYTES_TAIL_SIZE bytes can go to the sink
+    size_t emit = total - BYTES_TAIL_SIZE;
+    size_t from_tail = emit < fhttp->bytes_tail_len ? emit : fhttp->bytes_tail_len;
+    size_t from_data = emit - from_tail;
+    bool success = flipper_http_sink_write(fhttp, fhttp->bytes_tail, from_tail) &&
+                   flipper_http_sink_write(fhttp, data, from_data);
+
+    memmove(fhttp->bytes_tail, &fhttp->bytes_tail[from_tail], fhttp->bytes_tail_len - from_tail);
+    fhttp->bytes_tail_len -= from_tail;
+    memcpy(&fhttp->bytes_tail[fhttp->bytes_tail_len], &data[from_data], data_size - from_data);
+    fhttp->bytes_tail_len += data_size - from_data;
+    return success;
+}
+
+// Finish the response, dropping the end marker (and the line ending after it) from the held back bytes
+static bool flipper_http_sink_end(FlipperHTTP *fhttp, bool completed, const char *end_marker)
+{
+    if (!fhttp->sink_open)
+    {
+        fhttp->bytes_tail_len = 0;
+        return true;
+    }
+    size_t tail_len = fhttp->bytes_tail_len;
+    size_t marker_len = end_marker ? strlen(end_marker) : 0;
+    if (marker_len > 0 && tail_len >= marker_len)
+    {
+        for (size_t i = tail_len - marker_len + 1; i-- > 0;)
+        {
+            if (memcmp(&fhttp->bytes_tail[i], end_marker, marker_len) == 0)
+            {
+                tail_len = i;
+                break;
+            }
+        }
+    }
+    bool success = flipper_http_sink_write(fhttp, fhttp->bytes_tail, tail_len);
+    fhttp->bytes_tail_len = 0;
+    fhttp->sink_open = false;
+    if (fhttp->sink.close && !fhttp->sink.close(completed, fhttp->sink.context))
+    {
+        success = false;
+    }
+    return success;
+}
+
 FuriString *flipper_http_load_from_file(char *file_path)
 {
     // Open the storage record
@@ -240,6 +663,285 @@ FuriString *flipper_http_load_from_file_with_limit(char *file_path, size_t limit
     return str_result;
 }
 
+// Function to count the bytes lost to a full stream buffer or thrown away with a bad frame
+static uint32_t flipper_http_lost_bytes(FlipperHTTP *fhttp)
+{
+    return fhttp->rx_dropped + fhttp->frame_dropped;
+}
+
+// Function to record the bytes lost since the last command was sent
+static uint32_t flipper_http_update_dropped(FlipperHTTP *fhttp)
+{
+    fhttp->request_dropped = flipper_http_lost_bytes(fhttp) - fhttp->request_dropped_start;
+    return fhttp->request_dropped;
+}
+
+// Function to send bytes to the board, one caller at a time so nothing lands inside another's line
+static void flipper_http_tx(FlipperHTTP *fhttp, const uint8_t *data, size_t data_size)
+{
+    furi_check(furi_mutex_acquire(fhttp->tx_mutex, FuriWaitForever) == FuriStatusOk);
+    furi_hal_serial_tx(fhttp->serial_handle, data, data_size);
+    furi_mutex_release(fhttp->tx_mutex);
+}
+
+// Function to pause the board with XOFF or let it transmit again with XON
+static void flipper_http_flow_set(FlipperHTTP *fhttp, bool paused)
+{
+    if (fhttp->rx_paused == paused)
+    {
+        return;
+    }
+    // XOFF and XON go out between command lines, never inside one
+    furi_check(furi_mutex_acquire(fhttp->tx_mutex, FuriWaitForever) == FuriStatusOk);
+    FURI_CRITICAL_ENTER();
+    bool changed = fhttp->rx_paused != paused;
+    fhttp->rx_paused = paused;
+    FURI_CRITICAL_EXIT();
+    if (changed)
+    {
+        const uint8_t byte = paused ? FLOW_XOFF : FLOW_XON;
+        if (paused)
+        {
+            fhttp->rx_pauses++;
+        }
+        furi_hal_serial_tx(fhttp->serial_handle, &byte, 1);
+    }
+    furi_mutex_release(fhttp->tx_mutex);
+}
+
+// Function to pause or resume the board as the stream buffer backlog grows and drains
+static void flipper_http_flow_update(FlipperHTTP *fhttp)
+{
+    if (!fhttp->flow_control)
+    {
+        return;
+    }
+    size_t backlog = furi_stream_buffer_bytes_available(fhttp->flipper_http_stream);
+    if (backlog >= RX_FLOW_PAUSE)
+    {
+        flipper_http_flow_set(fhttp, true);
+    }
+    else if (backlog <= RX_FLOW_RESUME)
+    {
+        flipper_http_flow_set(fhttp, false);
+    }
+}
+
+// Copy part of a line into rx_line_buffer, handing it to the callback whenever the buffer fills up
+static void flipper_http_buffer_line(FlipperHTTP *fhttp, const uint8_t *data, size_t len, size_t *rx_line_pos)
+{
+    while (len > 0)
+    {
+        size_t space = RX_LINE_BUFFER_SIZE - 1 - *rx_line_pos;
+        size_t copy_len = len < space ? len : space;
+        memcpy(&fhttp->rx_line_buffer[*rx_line_pos], data, copy_len);
+        *rx_line_pos += copy_len;
+        data += copy_len;
+        len -= copy_len;
+
+        if (*rx_line_pos >= RX_LINE_BUFFER_SIZE - 1)
+        {
+            fhttp->rx_line_buffer[*rx_line_pos] = '\0';
+            fhttp->handle_rx_line_cb(fhttp->rx_line_buffer, fhttp->callback_context);
+            *rx_line_pos = 0;
+        }
+    }
+}
+
+// Function to continue a CRC-16/CCITT-FALSE (polynomial 0x1021, start 0xFFFF) over more bytes
+static uint16_t flipper_http_crc16(uint16_t crc, const uint8_t *data, size_t len)
+{
+    // One lookup per nibble keeps the table at 32 bytes
+    static const uint16_t table[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF};
+    while (len-- > 0)
+    {
+        crc = (crc << 4) ^ table[(crc >> 12) ^ (*data >> 4)];
+        crc = (crc << 4) ^ table[(crc >> 12) ^ (*data & 0x0F)];
+        data++;
+    }
+    return crc;
+}
+
+// Pass a decoded piece of a compressed response body to the sink
+static bool flipper_http_sink_write_inflated(const uint8_t *data, size_t data_size, void *context)
+{
+    return flipper_http_sink_write((FlipperHTTP *)context, data, data_size);
+}
+
+// Check a received frame and hand its payload on; the payload is followed by its CRC, which is overwritten
+static void flipper_http_finish_frame(FlipperHTTP *fhttp, uint8_t *payload)
+{
+    uint16_t len = fhttp->frame_len;
+    uint16_t crc = flipper_http_crc16(fhttp->frame_crc, payload, len);
+    fhttp->frame_state = FlipperHTTPFrameStateSync;
+    if (crc != (uint16_t)(payload[len] | (payload[len + 1] << 8)))
+    {
+        // The bytes are gone, so the response they belonged to is reported incomplete
+        FURI_LOG_E(HTTP_TAG, "Dropped frame with bad CRC.");
+        fhttp->frame_errors++;
+        fhttp->frame_dropped += 1 + FRAME_HEADER_SIZE + len + FRAME_CRC_SIZE;
+        return;
+    }
+
+    switch (fhttp->frame_header[0])
+    {
+    case FlipperHTTPFrameLine:
+        payload[len] = '\0';
+        fhttp->handle_rx_line_cb((const char *)payload, fhttp->callback_context);
+        break;
+    case FlipperHTTPFrameData:
+        if (fhttp->active_request == FlipperHTTPRequestNone)
+        {
+            break;
+        }
+        // Restart the timeout timer each time new data is received
+        furi_timer_restart(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
+        if (!fhttp->save_bytes && !fhttp->save_received_data)
+        {
+            break;
+        }
+        if (fhttp->compressed ? !heatshrink_stream_decode(&fhttp->inflate, payload, len, flipper_http_sink_write_inflated, fhttp)
+                              : !flipper_http_sink_write(fhttp, payload, len))
+        {
+            FURI_LOG_E(HTTP_TAG, "Failed to append data to file");
+            fhttp->save_bytes = false;
+            fhttp->save_received_data = false;
+        }
+        break;
+    default:
+        FURI_LOG_E(HTTP_TAG, "Ignored frame of unknown type %u.", fhttp->frame_header[0]);
+        break;
+    }
+}
+
+// Split a received chunk into frames, returning the bytes used
+// Frames that fit entirely inside the chunk are handled in place without a copy,
+// only frames that straddle chunk boundaries are assembled in rx_line_buffer.
+// Stops after the frame that switches the board back to lines.
+static size_t flipper_http_process_frames(FlipperHTTP *fhttp, uint8_t *chunk, size_t len)
+{
+    uint8_t *pos = chunk;
+    uint8_t *end = chunk + len;
+    while (pos < end && fhttp->framed)
+    {
+        switch (fhttp->frame_state)
+        {
+        case FlipperHTTPFrameStateSync:
+        {
+            uint8_t *sync = (uint8_t *)memchr(pos, FRAME_SYNC, end - pos);
+            pos = sync ? sync + 1 : end;
+            if (sync)
+            {
+                fhttp->frame_state = FlipperHTTPFrameStateHeader;
+                fhttp->frame_pos = 0;
+            }
+            break;
+        }
+        case FlipperHTTPFrameStateHeader:
+            fhttp->frame_header[fhttp->frame_pos++] = *pos++;
+            if (fhttp->frame_pos < FRAME_HEADER_SIZE)
+            {
+                break;
+            }
+            fhttp->frame_len = fhttp->frame_header[1] | (fhttp->frame_header[2] << 8);
+            if (fhttp->frame_len > FRAME_MAX_PAYLOAD)
+            {
+                // Not a real frame; look for the next sync byte right after this one
+                FURI_LOG_E(HTTP_TAG, "Dropped frame of %u bytes.", fhttp->frame_len);
+                fhttp->frame_errors++;
+                fhttp->frame_dropped += 1 + FRAME_HEADER_SIZE;
+                fhttp->frame_state = FlipperHTTPFrameStateSync;
+                break;
+            }
+            fhttp->frame_crc = flipper_http_crc16(0xFFFF, fhttp->frame_header, FRAME_HEADER_SIZE);
+            fhttp->frame_state = FlipperHTTPFrameStateBody;
+            fhttp->frame_pos = 0;
+            break;
+        case FlipperHTTPFrameStateBody:
+        {
+            size_t frame_size = fhttp->frame_len + FRAME_CRC_SIZE;
+            if (fhttp->frame_pos == 0 && (size_t)(end - pos) >= frame_size)
+            {
+                // Whole payload and CRC are inside this chunk
+                flipper_http_finish_frame(fhttp, pos);
+                pos += frame_size;
+                break;
+            }
+            size_t copy_len = frame_size - fhttp->frame_pos;
+            if (copy_len > (size_t)(end - pos))
+            {
+                copy_len = end - pos;
+            }
+            memcpy(&fhttp->rx_line_buffer[fhttp->frame_pos], pos, copy_len);
+            fhttp->frame_pos += copy_len;
+            pos += copy_len;
+            if (fhttp->frame_pos == frame_size)
+            {
+                flipper_http_finish_frame(fhttp, (uint8_t *)fhttp->rx_line_buffer);
+            }
+            break;
+        }
+        }
+    }
+    return pos - chunk;
+}
+
+// Split a received chunk into lines, or into frames once the board has switched to them
+// Lines that fit entirely inside the chunk are terminated in place and passed to the callback without a copy,
+// only lines that straddle chunk boundaries are assembled in rx_line_buffer.
+static void flipper_http_process_chunk(FlipperHTTP *fhttp, uint8_t *chunk, size_t len, size_t *rx_line_pos)
+{
+    uint8_t *pos = chunk;
+    uint8_t *end = chunk + len;
+    while (pos < end)
+    {
+        // The line that switched the board to frames may be followed by frames in the same chunk
+        if (fhttp->framed)
+        {
+            pos += flipper_http_process_frames(fhttp, pos, end - pos);
+            continue;
+        }
+
+        uint8_t *newline = (uint8_t *)memchr(pos, '\n', end - pos);
+        uint8_t *span_end = newline ? newline + 1 : end;
+
+        // Pass the received bytes (newline included) to the sink if saving is enabled
+        if (fhttp->save_bytes && !flipper_http_sink_write_bytes(fhttp, pos, span_end - pos))
+        {
+            FURI_LOG_E(HTTP_TAG, "Failed to append data to file");
+            fhttp->save_bytes = false;
+        }
+
+        // Handle line buffering only if callback is set (text data)
+        if (fhttp->handle_rx_line_cb)
+        {
+            if (!newline)
+            {
+                // Partial line, keep it until the rest arrives
+                flipper_http_buffer_line(fhttp, pos, end - pos, rx_line_pos);
+            }
+            else if (*rx_line_pos == 0)
+            {
+                // Whole line is inside this chunk
+                *newline = '\0';
+                fhttp->handle_rx_line_cb((const char *)pos, fhttp->callback_context);
+            }
+            else
+            {
+                // Finish the line started in a previous chunk
+                flipper_http_buffer_line(fhttp, pos, newline - pos, rx_line_pos);
+                fhttp->rx_line_buffer[*rx_line_pos] = '\0';
+                fhttp->handle_rx_line_cb(fhttp->rx_line_buffer, fhttp->callback_context);
+                *rx_line_pos = 0;
+            }
+        }
+
+        pos = span_end;
+    }
+}
+
 // UART worker thread
 /**
  * @brief      Worker thread to handle UART data asynchronously.
@@ -266,66 +968,36 @@ int32_t flipper_http_worker(void *context)
     while (1)
     {
         uint32_t events = furi_thread_flags_wait(
-            WorkerEvtStop | WorkerEvtRxDone, FuriFlagWaitAny, FuriWaitForever);
+            WorkerEvtStop | WorkerEvtRxDone | WorkerEvtTimeout | WorkerEvtFlow, FuriFlagWaitAny, FuriWaitForever);
         if (events & WorkerEvtStop)
         {
             break;
         }
+        if (events & WorkerEvtTimeout)
+        {
+            // The response will not complete, release the sink it was streaming into
+            flipper_http_flow_set(fhttp, false);
+            flipper_http_update_dropped(fhttp);
+            fhttp->frame_state = FlipperHTTPFrameStateSync;
+            fhttp->save_bytes = false;
+            flipper_http_sink_end(fhttp, false, NULL);
+            flipper_http_notify_complete(fhttp);
+        }
+        if (events & WorkerEvtFlow)
+        {
+            // The RX interrupt saw the backlog reach RX_FLOW_PAUSE
+            flipper_http_flow_update(fhttp);
+        }
         if (events & WorkerEvtRxDone)
         {
-            // Continuously read from the stream buffer until it's empty
-            while (!furi_stream_buffer_is_empty(fhttp->flipper_http_stream))
+            // Drain the stream buffer in chunks until it's empty
+            size_t received;
+            while ((received = furi_stream_buffer_receive(fhttp->flipper_http_stream, fhttp->rx_chunk, RX_CHUNK_SIZE, 0)) > 0)
             {
-                // Read one byte at a time
-                char c = 0;
-                size_t received = furi_stream_buffer_receive(fhttp->flipper_http_stream, &c, 1, 0);
-
-                if (received == 0)
-                {
-                    // No more data to read
-                    break;
-                }
-
-                // Append the received byte to the file if saving is enabled
-                if (fhttp->save_bytes)
-                {
-                    // Add byte to the buffer
-                    fhttp->file_buffer[fhttp->file_buffer_len++] = c;
-                    // Write to file if buffer is full
-                    if (fhttp->file_buffer_len >= FILE_BUFFER_SIZE)
-                    {
-                        if (!flipper_http_append_to_file(
-                                fhttp->file_buffer,
-                                fhttp->file_buffer_len,
-                                fhttp->just_started_bytes,
-                                fhttp->file_path))
-                        {
-                            FURI_LOG_E(HTTP_TAG, "Failed to append data to file");
-                        }
-                        fhttp->file_buffer_len = 0;
-                        fhttp->just_started_bytes = false;
-                    }
-                }
-
-                // Handle line buffering only if callback is set (text data)
-                if (fhttp->handle_rx_line_cb)
-                {
-                    // Handle line buffering
-                    if (c == '\n' || rx_line_pos >= RX_LINE_BUFFER_SIZE - 1)
-                    {
-                        fhttp->rx_line_buffer[rx_line_pos] = '\0'; // Null-terminate the line
-
-                        // Invoke the callback with the complete line
-                        fhttp->handle_rx_line_cb(fhttp->rx_line_buffer, fhttp->callback_context);
-
-                        // Reset the line buffer position
-                        rx_line_pos = 0;
-                    }
-                    else
-                    {
-                        fhttp->rx_line_buffer[rx_line_pos++] = c; // Add character to the line buffer
-                    }
-                }
+                flipper_http_process_chunk(fhttp, fhttp->rx_chunk, received, &rx_line_pos);
+
+                // Pause the board if the backlog grew while the chunk was handled, resume it once it is small again
+                flipper_http_flow_update(fhttp);
             }
         }
     }
@@ -350,13 +1022,13 @@ void get_timeout_timer_callback(void *context)
     FURI_LOG_E(HTTP_TAG, "Timeout reached without receiving the end.");
 
     // Reset the state
-    fhttp->started_receiving_get = false;
-    fhttp->started_receiving_post = false;
-    fhttp->started_receiving_put = false;
-    fhttp->started_receiving_delete = false;
+    fhttp->active_request = FlipperHTTPRequestNone;
 
     // Update UART state
     fhttp->state = ISSUE;
+
+    // Let the worker close the sink, it is the only thread writing to it
+    furi_thread_flags_set(fhttp->rx_thread_id, WorkerEvtTimeout);
 }
 
 // UART RX Handler Callback (Interrupt Context)
@@ -371,6 +1043,7 @@ void get_timeout_timer_callback(void *context)
 void _flipper_http_rx_callback(
     FuriHalSerialHandle *handle,
     FuriHalSerialRxEvent event,
+    size_t data_len,
     void *context)
 {
     FlipperHTTP *fhttp = (FlipperHTTP *)context;
@@ -379,11 +1052,45 @@ void _flipper_http_rx_callback(
         FURI_LOG_E(HTTP_TAG, "Failed to get context.");
         return;
     }
-    if (event == FuriHalSerialRxEventData)
+    if (event & (FuriHalSerialRxEventData | FuriHalSerialRxEventIdle))
     {
-        uint8_t data = furi_hal_serial_async_rx(handle);
-        furi_stream_buffer_send(fhttp->flipper_http_stream, &data, 1, 0);
-        furi_thread_flags_set(fhttp->rx_thread_id, WorkerEvtRxDone);
+        // Move everything the DMA has collected into the stream buffer in bulk
+        uint8_t data[64];
+        bool overflow = false;
+        while (data_len > 0)
+        {
+            size_t len = furi_hal_serial_dma_rx(handle, data, data_len < sizeof(data) ? data_len : sizeof(data));
+            if (len == 0)
+            {
+                break;
+            }
+            // Bytes that do not fit are lost; count them so the response can be reported incomplete
+            size_t sent = furi_stream_buffer_send(fhttp->flipper_http_stream, data, len, 0);
+            if (sent < len)
+            {
+                fhttp->rx_dropped += len - sent;
+                overflow = true;
+            }
+            data_len -= len;
+        }
+        if (overflow)
+        {
+            fhttp->rx_overflows++;
+        }
+
+        // Ask the worker to pause the board before it falls so far behind that bytes are lost
+        if (fhttp->flow_control && !fhttp->rx_paused &&
+            furi_stream_buffer_bytes_available(fhttp->flipper_http_stream) >= RX_FLOW_PAUSE)
+        {
+            furi_thread_flags_set(fhttp->rx_thread_id, WorkerEvtFlow);
+        }
+
+        // Only wake the worker when the line goes idle or enough data is waiting
+        if ((event & FuriHalSerialRxEventIdle) ||
+            furi_stream_buffer_bytes_available(fhttp->flipper_http_stream) >= RX_BUF_HIGH_WATER)
+        {
+            furi_thread_flags_set(fhttp->rx_thread_id, WorkerEvtRxDone);
+        }
     }
 }
 
@@ -403,10 +1110,27 @@ FlipperHTTP *flipper_http_alloc()
     }
     memset(fhttp, 0, sizeof(FlipperHTTP)); // Initialize allocated memory to zero
 
+    // Allocated before the worker starts, it signals completions from the first line on
+    fhttp->events = furi_event_flag_alloc();
+    fhttp->tx_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+
+    // Created once, every response saved to a file reuses its thread and buffers
+    fhttp->file_writer = flipper_http_file_writer_alloc();
+    if (!fhttp->file_writer)
+    {
+        furi_event_flag_free(fhttp->events);
+        furi_mutex_free(fhttp->tx_mutex);
+        free(fhttp);
+        return NULL;
+    }
+
     fhttp->flipper_http_stream = furi_stream_buffer_alloc(RX_BUF_SIZE, 1);
     if (!fhttp->flipper_http_stream)
     {
         FURI_LOG_E(HTTP_TAG, "Failed to allocate UART stream buffer.");
+        furi_event_flag_free(fhttp->events);
+        furi_mutex_free(fhttp->tx_mutex);
+        flipper_http_file_writer_free(fhttp->file_writer);
         free(fhttp);
         return NULL;
     }
@@ -416,18 +1140,26 @@ FlipperHTTP *flipper_http_alloc()
     {
         FURI_LOG_E(HTTP_TAG, "Failed to allocate UART thread.");
         furi_stream_buffer_free(fhttp->flipper_http_stream);
+        furi_event_flag_free(fhttp->events);
+        furi_mutex_free(fhttp->tx_mutex);
+        flipper_http_file_writer_free(fhttp->file_writer);
         free(fhttp);
         return NULL;
     }
 
     furi_thread_set_name(fhttp->rx_thread, "FlipperHTTP_RxThread");
-    furi_thread_set_stack_size(fhttp->rx_thread, 1024);
+    // The deepest path, a decoded frame fed to a parser sink whose link callback fills a file sink,
+    // takes about 0.7 KB before logging; RX_THREAD_STACK_SIZE leaves room for FURI_LOG_E on top of it
+    furi_thread_set_stack_size(fhttp->rx_thread, RX_THREAD_STACK_SIZE);
     furi_thread_set_context(fhttp->rx_thread, fhttp); // Corrected context
     furi_thread_set_callback(fhttp->rx_thread, flipper_http_worker);
 
     fhttp->handle_rx_line_cb = flipper_http_rx_callback;
     fhttp->callback_context = fhttp;
 
+    // Responses are saved to fhttp->file_path unless another sink is set
+    flipper_http_set_sink_file(fhttp);
+
     furi_thread_start(fhttp->rx_thread);
     fhttp->rx_thread_id = furi_thread_get_id(fhttp->rx_thread);
 
@@ -440,6 +1172,9 @@ FlipperHTTP *flipper_http_alloc()
         furi_thread_join(fhttp->rx_thread);
         furi_thread_free(fhttp->rx_thread);
         furi_stream_buffer_free(fhttp->flipper_http_stream);
+        furi_event_flag_free(fhttp->events);
+        furi_mutex_free(fhttp->tx_mutex);
+        flipper_http_file_writer_free(fhttp->file_writer);
         free(fhttp);
         return NULL;
     }
@@ -453,6 +1188,9 @@ FlipperHTTP *flipper_http_alloc()
         furi_thread_join(fhttp->rx_thread);
         furi_thread_free(fhttp->rx_thread);
         furi_stream_buffer_free(fhttp->flipper_http_stream);
+        furi_event_flag_free(fhttp->events);
+        furi_mutex_free(fhttp->tx_mutex);
+        flipper_http_file_writer_free(fhttp->file_writer);
         free(fhttp);
         return NULL;
     }
@@ -463,8 +1201,8 @@ FlipperHTTP *flipper_http_alloc()
     // Enable RX direction
     furi_hal_serial_enable_direction(fhttp->serial_handle, FuriHalSerialDirectionRx);
 
-    // Start asynchronous RX with the corrected callback and context
-    furi_hal_serial_async_rx_start(fhttp->serial_handle, _flipper_http_rx_callback, fhttp, false); // Corrected context
+    // Start DMA RX so bytes are collected in bulk instead of one interrupt per byte
+    furi_hal_serial_dma_rx_start(fhttp->serial_handle, _flipper_http_rx_callback, fhttp, false);
 
     // Wait for the TX to complete to ensure UART is ready
     furi_hal_serial_tx_wait_complete(fhttp->serial_handle);
@@ -480,7 +1218,7 @@ FlipperHTTP *flipper_http_alloc()
     {
         FURI_LOG_E(HTTP_TAG, "Failed to allocate HTTP request timeout timer.");
         // Cleanup resources
-        furi_hal_serial_async_rx_stop(fhttp->serial_handle);
+        furi_hal_serial_dma_rx_stop(fhttp->serial_handle);
         furi_hal_serial_disable_direction(fhttp->serial_handle, FuriHalSerialDirectionRx);
         furi_hal_serial_control_release(fhttp->serial_handle);
         furi_hal_serial_deinit(fhttp->serial_handle);
@@ -488,6 +1226,9 @@ FlipperHTTP *flipper_http_alloc()
         furi_thread_join(fhttp->rx_thread);
         furi_thread_free(fhttp->rx_thread);
         furi_stream_buffer_free(fhttp->flipper_http_stream);
+        furi_event_flag_free(fhttp->events);
+        furi_mutex_free(fhttp->tx_mutex);
+        flipper_http_file_writer_free(fhttp->file_writer);
         free(fhttp);
         return NULL;
     }
@@ -501,7 +1242,7 @@ FlipperHTTP *flipper_http_alloc()
         FURI_LOG_E(HTTP_TAG, "Failed to allocate memory for last_response.");
         // Cleanup resources
         furi_timer_free(fhttp->get_timeout_timer);
-        furi_hal_serial_async_rx_stop(fhttp->serial_handle);
+        furi_hal_serial_dma_rx_stop(fhttp->serial_handle);
         furi_hal_serial_disable_direction(fhttp->serial_handle, FuriHalSerialDirectionRx);
         furi_hal_serial_control_release(fhttp->serial_handle);
         furi_hal_serial_deinit(fhttp->serial_handle);
@@ -509,12 +1250,17 @@ FlipperHTTP *flipper_http_alloc()
         furi_thread_join(fhttp->rx_thread);
         furi_thread_free(fhttp->rx_thread);
         furi_stream_buffer_free(fhttp->flipper_http_stream);
+        furi_event_flag_free(fhttp->events);
+        furi_mutex_free(fhttp->tx_mutex);
+        flipper_http_file_writer_free(fhttp->file_writer);
         free(fhttp);
         return NULL;
     }
     memset(fhttp->last_response, 0, RX_BUF_SIZE); // Initialize last_response
 
     fhttp->state = IDLE;
+    // Every connection starts at BAUDRATE; a long-lived one may move to a faster rate with flipper_http_negotiate_baudrate
+    fhttp->baudrate = BAUDRATE;
 
     // FURI_LOG_I(HTTP_TAG, "UART initialized successfully.");
     return fhttp;
@@ -539,8 +1285,21 @@ void flipper_http_free(FlipperHTTP *fhttp)
         FURI_LOG_E(HTTP_TAG, "UART handle is NULL. Already deinitialized?");
         return;
     }
-    // Stop asynchronous RX
-    furi_hal_serial_async_rx_stop(fhttp->serial_handle);
+    // Leave the board sending lines at BAUDRATE, which is what the next connection expects
+    if (fhttp->framed)
+    {
+        flipper_http_send_data(fhttp, "[FRAME/OFF]");
+    }
+    if (fhttp->baudrate != BAUDRATE)
+    {
+        char command[48];
+        snprintf(command, sizeof(command), "[BAUD]{\"baudrate\":%lu}", (unsigned long)BAUDRATE);
+        flipper_http_send_data(fhttp, command);
+        furi_hal_serial_tx_wait_complete(fhttp->serial_handle);
+    }
+
+    // Stop DMA RX
+    furi_hal_serial_dma_rx_stop(fhttp->serial_handle);
 
     // Release and deinitialize the serial handle
     furi_hal_serial_disable_direction(fhttp->serial_handle, FuriHalSerialDirectionRx);
@@ -554,6 +1313,13 @@ void flipper_http_free(FlipperHTTP *fhttp)
     // Free the thread resources
     furi_thread_free(fhttp->rx_thread);
 
+    // Close any response that was still streaming to the sink
+    flipper_http_sink_end(fhttp, false, NULL);
+
+    // Stop the file writer once nothing can be writing through it
+    flipper_http_file_writer_free(fhttp->file_writer);
+    fhttp->file_writer = NULL;
+
     // Free the stream buffer
     furi_stream_buffer_free(fhttp->flipper_http_stream);
 
@@ -564,6 +1330,20 @@ void flipper_http_free(FlipperHTTP *fhttp)
         fhttp->get_timeout_timer = NULL;
     }
 
+    // Free the TX lock once the worker and every command are done with it
+    if (fhttp->tx_mutex)
+    {
+        furi_mutex_free(fhttp->tx_mutex);
+        fhttp->tx_mutex = NULL;
+    }
+
+    // Free the completion events
+    if (fhttp->events)
+    {
+        furi_event_flag_free(fhttp->events);
+        fhttp->events = NULL;
+    }
+
     // Free the last response
     if (fhttp->last_response)
     {
@@ -617,12 +1397,16 @@ bool flipper_http_send_data(FlipperHTTP *fhttp, const char *data)
                                      (strstr(send_buffer, "[WIFI/CONNECT]") == NULL)))
     {
         FURI_LOG_E("FlipperHTTP", "Cannot send data while INACTIVE.");
-        fhttp->last_response = "Cannot send data while INACTIVE.";
+        snprintf(fhttp->last_response, RX_BUF_SIZE, "Cannot send data while INACTIVE.");
         return false;
     }
 
+    // Bytes lost from here on count against this command's response
+    fhttp->request_dropped_start = flipper_http_lost_bytes(fhttp);
+    fhttp->request_dropped = 0;
+
     fhttp->state = SENDING;
-    furi_hal_serial_tx(fhttp->serial_handle, (const uint8_t *)send_buffer, send_length);
+    flipper_http_tx(fhttp, (const uint8_t *)send_buffer, send_length);
 
     // Uncomment below line to log the data sent over UART
     // FURI_LOG_I("FlipperHTTP", "Sent data over UART: %s", send_buffer);
@@ -654,10 +1438,259 @@ bool flipper_http_ping(FlipperHTTP *fhttp)
     }
     // set state as INACTIVE to be made IDLE if PONG is received
     fhttp->state = INACTIVE;
+    // The board answers a PING in lines and stays with them until framing is negotiated again
+    fhttp->framed = false;
+    fhttp->compressed = false;
+    fhttp->frame_state = FlipperHTTPFrameStateSync;
     // The response will be handled asynchronously via the callback
     return true;
 }
 
+// Function to send a command and wait for the status line that answers it
+/**
+ * @brief      Send a command and wait for the first status line the board sends back.
+ * @return     The marker of the answer, or FlipperHTTPMarkerNone if none arrived within timeout_ms.
+ * @param fhttp The FlipperHTTP context
+ * @param command The command to send.
+ * @param timeout_ms Time the board has to answer.
+ * @note       The answer is handled by the UART worker, which therefore must not be the caller.
+ */
+static FlipperHTTPMarker flipper_http_command(FlipperHTTP *fhttp, const char *command, uint32_t timeout_ms)
+{
+    furi_check(furi_thread_get_current_id() != furi_thread_get_id(fhttp->rx_thread));
+    furi_event_flag_clear(fhttp->events, FlipperHTTPEvtComplete);
+    fhttp->answer = FlipperHTTPMarkerNone;
+    fhttp->answer_pending = true;
+    if (!flipper_http_send_data(fhttp, command))
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to send command: %s", command);
+        fhttp->answer_pending = false;
+        return FlipperHTTPMarkerNone;
+    }
+    uint32_t start = furi_get_tick();
+    while (fhttp->answer_pending && furi_get_tick() - start < furi_ms_to_ticks(timeout_ms))
+    {
+        furi_event_flag_wait(fhttp->events, FlipperHTTPEvtComplete, FuriFlagWaitAny, furi_ms_to_ticks(timeout_ms));
+    }
+    if (fhttp->answer_pending)
+    {
+        fhttp->answer_pending = false;
+        FURI_LOG_I(HTTP_TAG, "No answer to: %s", command);
+    }
+    return fhttp->answer;
+}
+
+// Function to ping the board and wait for its PONG
+/**
+ * @brief      Send a PING and wait for the board to answer it.
+ * @return     true if the board answered with PONG, false otherwise.
+ * @param fhttp The FlipperHTTP context
+ * @param timeout_ms The longest time to wait for the PONG.
+ * @note       Blocks until the PONG arrives or timeout_ms passes.
+ */
+bool flipper_http_ping_wait(FlipperHTTP *fhttp, uint32_t timeout_ms)
+{
+    if (!fhttp)
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to get context.");
+        return false;
+    }
+    // The board answers a PING in lines and stays with them until framing is negotiated again
+    fhttp->framed = false;
+    fhttp->compressed = false;
+    fhttp->frame_state = FlipperHTTPFrameStateSync;
+    // PONGs are counted, since a quick one can be handled before flipper_http_ping marks the state INACTIVE
+    // and the board may still owe an answer to a line sent before, which then comes first
+    uint32_t pongs = fhttp->pongs;
+    uint32_t start = furi_get_tick();
+    flipper_http_command(fhttp, "[PING]", timeout_ms);
+    while (fhttp->pongs == pongs && furi_get_tick() - start < furi_ms_to_ticks(timeout_ms))
+    {
+        furi_event_flag_wait(fhttp->events, FlipperHTTPEvtComplete, FuriFlagWaitAny, furi_ms_to_ticks(timeout_ms));
+    }
+    if (fhttp->pongs == pongs)
+    {
+        return false;
+    }
+    fhttp->state = IDLE;
+    return true;
+}
+
+// Function to negotiate a faster baud rate with the board
+/**
+ * @brief      Move the UART from BAUDRATE to the fastest rate in BAUDRATE_FAST that the board confirms.
+ * @return     true if a faster rate is in use, false if the UART stays at BAUDRATE.
+ * @param fhttp The FlipperHTTP context
+ * @note       Blocks while the board answers; a board that does not answer at all costs one BAUD_TIMEOUT_MS.
+ *             Never call it from a timer callback: it would stall every timer for that long.
+ */
+bool flipper_http_negotiate_baudrate(FlipperHTTP *fhttp)
+{
+    if (!fhttp)
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to get context.");
+        return false;
+    }
+    if (fhttp->baudrate != BAUDRATE)
+    {
+        // Already negotiated for this connection
+        return true;
+    }
+    static const uint32_t baudrates[] = BAUDRATE_FAST;
+    for (size_t i = 0; i < COUNT_OF(baudrates); i++)
+    {
+        char command[48];
+        snprintf(command, sizeof(command), "[BAUD]{\"baudrate\":%lu}", (unsigned long)baudrates[i]);
+        FlipperHTTPMarker answer = flipper_http_command(fhttp, command, BAUD_TIMEOUT_MS);
+        if (answer == FlipperHTTPMarkerNone)
+        {
+            // No board, or one that is busy; slower rates would only wait as long again
+            break;
+        }
+        if (answer != FlipperHTTPMarkerBaudOk)
+        {
+            // Refused, a slower rate may still be accepted
+            continue;
+        }
+
+        // The board sent [BAUD/OK] at the old rate and listens at the new one from now on
+        furi_hal_serial_set_br(fhttp->serial_handle, baudrates[i]);
+        fhttp->baudrate = baudrates[i];
+        if (flipper_http_ping_wait(fhttp, BAUD_TIMEOUT_MS))
+        {
+            FURI_LOG_I(HTTP_TAG, "UART running at %lu baud.", (unsigned long)baudrates[i]);
+            return true;
+        }
+
+        // No PONG at the new rate: the board goes back to BAUDRATE once BAUD_FALLBACK_MS pass without a PING
+        FURI_LOG_E(HTTP_TAG, "No PONG at %lu baud, falling back.", (unsigned long)baudrates[i]);
+        furi_hal_serial_set_br(fhttp->serial_handle, BAUDRATE);
+        fhttp->baudrate = BAUDRATE;
+        furi_delay_ms(BAUD_FALLBACK_MS);
+        // End the garbage the board made of the PING, so the next one starts a line of its own
+        const uint8_t newline = '\n';
+        flipper_http_tx(fhttp, &newline, 1);
+        if (!flipper_http_ping_wait(fhttp, BAUD_TIMEOUT_MS))
+        {
+            FURI_LOG_E(HTTP_TAG, "Board did not answer after falling back to %lu baud.", (unsigned long)BAUDRATE);
+            break;
+        }
+    }
+    return false;
+}
+
+// Function to turn flow control on or off
+/**
+ * @brief      Ask the board to pause when the RX stream buffer is nearly full and resume once it drains.
+ * @return     true if flow control is on when the function returns, false otherwise.
+ * @param fhttp The FlipperHTTP context
+ * @param enable true to turn flow control on, false to turn it off.
+ * @note       Blocks until the board answers or FLOW_CONTROL_TIMEOUT_MS passes.
+ */
+bool flipper_http_flow_control(FlipperHTTP *fhttp, bool enable)
+{
+    if (!fhttp)
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to get context.");
+        return false;
+    }
+    if (!enable)
+    {
+        if (fhttp->flow_control)
+        {
+            fhttp->flow_control = false;
+            flipper_http_flow_set(fhttp, false);
+            flipper_http_send_data(fhttp, "[FLOW/OFF]");
+        }
+        return false;
+    }
+    if (fhttp->flow_control)
+    {
+        return true;
+    }
+
+    // Firmware without flow control answers with something else, or not at all
+    fhttp->flow_control = flipper_http_command(fhttp, "[FLOW/ON]", FLOW_CONTROL_TIMEOUT_MS) == FlipperHTTPMarkerFlowOn;
+    FURI_LOG_I(HTTP_TAG, "Flow control %s.", fhttp->flow_control ? "on" : "not supported");
+    return fhttp->flow_control;
+}
+
+// Function to switch the board between lines and frames
+/**
+ * @brief      Ask the board to send frames instead of lines, so response bodies are never scanned for markers.
+ * @return     true if the board sends frames when the function returns, false otherwise.
+ * @param fhttp The FlipperHTTP context
+ * @param enable true to switch to frames, false to switch back to lines.
+ * @note       Blocks until the board answers or FRAMING_TIMEOUT_MS passes.
+ */
+bool flipper_http_framing(FlipperHTTP *fhttp, bool enable)
+{
+    if (!fhttp)
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to get context.");
+        return false;
+    }
+    if (fhttp->framed == enable)
+    {
+        return enable;
+    }
+
+    // The RX callback switches the parser as soon as the answer arrives, the board switches right after sending it
+    if (flipper_http_command(fhttp, enable ? "[FRAME/ON]" : "[FRAME/OFF]", FRAMING_TIMEOUT_MS) == FlipperHTTPMarkerNone &&
+        !enable)
+    {
+        // Lines are what the board sends when it has not understood [FRAME/OFF] either
+        fhttp->framed = false;
+    }
+    FURI_LOG_I(HTTP_TAG, "Board sends %s.", fhttp->framed ? "frames" : "lines");
+    return fhttp->framed;
+}
+
+// Function to turn compression of response bodies on or off
+/**
+ * @brief      Ask the board to compress response bodies, which are decoded as they arrive.
+ * @return     true if the board compresses response bodies when the function returns, false otherwise.
+ * @param fhttp The FlipperHTTP context
+ * @param enable true to turn compression on, false to turn it off.
+ * @note       Blocks until the board answers or FRAMING_TIMEOUT_MS passes.
+ */
+bool flipper_http_compression(FlipperHTTP *fhttp, bool enable)
+{
+    if (!fhttp)
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to get context.");
+        return false;
+    }
+    if (fhttp->compressed == enable)
+    {
+        return enable;
+    }
+    if (!enable)
+    {
+        flipper_http_command(fhttp, "[COMPRESS/OFF]", FRAMING_TIMEOUT_MS);
+        fhttp->compressed = false;
+        return false;
+    }
+    if (!fhttp->framed)
+    {
+        // A compressed body would be cut into lines and searched for the end marker
+        FURI_LOG_E(HTTP_TAG, "Compression needs framing.");
+        return false;
+    }
+
+    // The RX callback turns compression on with the answer, before any body can follow it
+    char command[96];
+    snprintf(
+        command,
+        sizeof(command),
+        "[COMPRESS/ON]{\"algorithm\":\"heatshrink\",\"window\":%d,\"lookahead\":%d}",
+        HEATSHRINK_STREAM_WINDOW_BITS,
+        HEATSHRINK_STREAM_LOOKAHEAD_BITS);
+    flipper_http_command(fhttp, command, FRAMING_TIMEOUT_MS);
+    FURI_LOG_I(HTTP_TAG, "Compression %s.", fhttp->compressed ? "on" : "not supported");
+    return fhttp->compressed;
+}
+
 // Function to list available commands
 /**
  * @brief      Send a command to list available commands.
@@ -1326,43 +2359,146 @@ bool flipper_http_delete_request_with_headers(
     // The response will be handled asynchronously via the callback
     return true;
 }
-// Function to trim leading and trailing spaces and newlines from a constant string
-static char *trim(const char *str)
+// Function to store a status line in last_response without leading and trailing whitespace
+static void flipper_http_set_last_response(FlipperHTTP *fhttp, const char *line)
 {
-    const char *end;
-    char *trimmed_str;
-    size_t len;
-
-    // Trim leading space
-    while (isspace((unsigned char)*str))
-        str++;
-
-    // All spaces?
-    if (*str == 0)
-        return strdup(""); // Return an empty string if all spaces
-
-    // Trim trailing space
-    end = str + strlen(str) - 1;
-    while (end > str && isspace((unsigned char)*end))
-        end--;
+    // Trim by narrowing a view of the line, nothing is copied until it is stored
+    while (isspace((unsigned char)*line))
+        line++;
+    size_t len = strlen(line);
+    while (len > 0 && isspace((unsigned char)line[len - 1]))
+        len--;
+
+    // Keep the previous response if the line is empty
+    if (len == 0)
+        return;
 
-    // Set length for the trimmed string
-    len = end - str + 1;
+    if (len > RX_BUF_SIZE - 1)
+        len = RX_BUF_SIZE - 1;
+    memcpy(fhttp->last_response, line, len);
+    fhttp->last_response[len] = '\0';
+}
 
-    // Allocate space for the trimmed string and null terminator
-    trimmed_str = (char *)malloc(len + 1);
-    if (trimmed_str == NULL)
+// Function to recognize the status marker at the start of a line
+/**
+ * @brief      Classify a line by the marker it starts with.
+ * @return     The marker, or FlipperHTTPMarkerNone if the line does not start with a known marker.
+ * @param      line  The received line.
+ * @note       Only the bracketed prefix is inspected, so body lines cost a single comparison.
+ */
+static FlipperHTTPMarker flipper_http_classify_line(const char *line)
+{
+    if (line[0] != '[')
     {
-        return NULL; // Handle memory allocation failure
+        return FlipperHTTPMarkerNone;
     }
 
-    // Copy the trimmed part of the string into trimmed_str
-    strncpy(trimmed_str, str, len);
-    trimmed_str[len] = '\0'; // Null terminate the string
+    // Find the closing bracket within the longest marker name
+    const char *name = line + 1;
+    size_t len = 0;
+    while (name[len] != ']')
+    {
+        if (name[len] == '\0' || len == 14) // strlen("DELETE/SUCCESS")
+        {
+            return FlipperHTTPMarkerNone;
+        }
+        len++;
+    }
+
+#define MARKER_IS(str) (len == sizeof(str) - 1 && memcmp(name, str, len) == 0)
+    switch (name[0])
+    {
+    case 'S':
+        return MARKER_IS("SUCCESS") ? FlipperHTTPMarkerSuccess : FlipperHTTPMarkerNone;
+    case 'C':
+        if (MARKER_IS("CONNECTED"))
+            return FlipperHTTPMarkerConnected;
+        if (MARKER_IS("COMPRESS/ON"))
+            return FlipperHTTPMarkerCompressOn;
+        return FlipperHTTPMarkerNone;
+    case 'I':
+        return MARKER_IS("INFO") ? FlipperHTTPMarkerInfo : FlipperHTTPMarkerNone;
+    case 'E':
+        return MARKER_IS("ERROR") ? FlipperHTTPMarkerError : FlipperHTTPMarkerNone;
+    case 'P':
+        if (MARKER_IS("PONG"))
+            return FlipperHTTPMarkerPong;
+        if (MARKER_IS("POST/SUCCESS"))
+            return FlipperHTTPMarkerPostSuccess;
+        if (MARKER_IS("POST/END"))
+            return FlipperHTTPMarkerPostEnd;
+        if (MARKER_IS("PUT/SUCCESS"))
+            return FlipperHTTPMarkerPutSuccess;
+        if (MARKER_IS("PUT/END"))
+            return FlipperHTTPMarkerPutEnd;
+        return FlipperHTTPMarkerNone;
+    case 'G':
+        if (MARKER_IS("GET/SUCCESS"))
+            return FlipperHTTPMarkerGetSuccess;
+        if (MARKER_IS("GET/END"))
+            return FlipperHTTPMarkerGetEnd;
+        return FlipperHTTPMarkerNone;
+    case 'D':
+        if (MARKER_IS("DELETE/SUCCESS"))
+            return FlipperHTTPMarkerDeleteSuccess;
+        if (MARKER_IS("DELETE/END"))
+            return FlipperHTTPMarkerDeleteEnd;
+        if (MARKER_IS("DISCONNECTED"))
+            return FlipperHTTPMarkerDisconnected;
+        return FlipperHTTPMarkerNone;
+    case 'B':
+        return MARKER_IS("BAUD/OK") ? FlipperHTTPMarkerBaudOk : FlipperHTTPMarkerNone;
+    case 'F':
+        if (MARKER_IS("FLOW/ON"))
+            return FlipperHTTPMarkerFlowOn;
+        if (MARKER_IS("FRAME/ON"))
+            return FlipperHTTPMarkerFrameOn;
+        if (MARKER_IS("FRAME/OFF"))
+            return FlipperHTTPMarkerFrameOff;
+        return FlipperHTTPMarkerNone;
+    default:
+        return FlipperHTTPMarkerNone;
+    }
+#undef MARKER_IS
+}
 
-    return trimmed_str;
+// Function to check for the end marker of a response
+/**
+ * @brief      Check if a response line ends with the given end marker.
+ * @return     true if the line ends with the marker, ignoring trailing whitespace
+ * @param      line    The received line.
+ * @param      marker  The end marker, e.g. "[GET/END]".
+ * @note       In bytes mode the marker follows the last chunk of data on the same line.
+ *             Lines that do not end with ']' are rejected after a single comparison.
+ */
+static bool flipper_http_line_ends_with(const char *line, const char *marker)
+{
+    size_t len = strlen(line);
+    while (len > 0 && isspace((unsigned char)line[len - 1]))
+        len--;
+    if (len == 0 || line[len - 1] != ']')
+        return false;
+    size_t marker_len = strlen(marker);
+    return len >= marker_len && memcmp(line + len - marker_len, marker, marker_len) == 0;
 }
 
+// How the response of each kind of request is received
+typedef struct
+{
+    const char *name;          // Method name, for logging
+    FlipperHTTPMarker success; // Marker that starts the response
+    const char *end_marker;    // Marker that ends the response
+    bool bytes;                // Bytes responses are supported; the end marker then trails the data
+} FlipperHTTPRequestInfo;
+
+static const FlipperHTTPRequestInfo flipper_http_requests[FlipperHTTPRequestCount] = {
+    [FlipperHTTPRequestNone] = {"NONE", FlipperHTTPMarkerNone, NULL, false},
+    [FlipperHTTPRequestGet] = {"GET", FlipperHTTPMarkerGetSuccess, "[GET/END]", true},
+    [FlipperHTTPRequestPost] = {"POST", FlipperHTTPMarkerPostSuccess, "[POST/END]", true},
+    [FlipperHTTPRequestPut] = {"PUT", FlipperHTTPMarkerPutSuccess, "[PUT/END]", false},
+    [FlipperHTTPRequestDelete] = {"DELETE", FlipperHTTPMarkerDeleteSuccess, "[DELETE/END]", false},
+};
+
 // Function to handle received data asynchronously
 /**
  * @brief      Callback function to handle received data asynchronously.
@@ -1385,20 +2521,11 @@ void flipper_http_rx_callback(const char *line, void *context)
         return;
     }
 
-    // Trim the received line to check if it's empty
-    char *trimmed_line = trim(line);
-    if (trimmed_line != NULL && trimmed_line[0] != '\0')
+    // Response bodies go to the sink; only status lines are kept in last_response
+    if (fhttp->active_request == FlipperHTTPRequestNone)
     {
-        // if the line is not [GET/END] or [POST/END] or [PUT/END] or [DELETE/END]
-        if (strstr(trimmed_line, "[GET/END]") == NULL &&
-            strstr(trimmed_line, "[POST/END]") == NULL &&
-            strstr(trimmed_line, "[PUT/END]") == NULL &&
-            strstr(trimmed_line, "[DELETE/END]") == NULL)
-        {
-            strncpy(fhttp->last_response, trimmed_line, RX_BUF_SIZE);
-        }
+        flipper_http_set_last_response(fhttp, line);
     }
-    free(trimmed_line); // Free the allocated memory for trimmed_line
 
     if (fhttp->state != INACTIVE && fhttp->state != ISSUE)
     {
@@ -1408,312 +2535,151 @@ void flipper_http_rx_callback(const char *line, void *context)
     // Uncomment below line to log the data received over UART
     // FURI_LOG_I(HTTP_TAG, "Received UART line: %s", line);
 
-    // Check if we've started receiving data from a GET request
-    if (fhttp->started_receiving_get)
+    // Check if we've started receiving the response of a request
+    if (fhttp->active_request != FlipperHTTPRequestNone)
     {
+        const FlipperHTTPRequestInfo *request = &flipper_http_requests[fhttp->active_request];
+
         // Restart the timeout timer each time new data is received
         furi_timer_restart(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
 
-        if (strstr(line, "[GET/END]") != NULL)
+        if (flipper_http_line_ends_with(line, request->end_marker))
         {
-            FURI_LOG_I(HTTP_TAG, "GET request completed.");
-            // Stop the timer since we've completed the GET request
+            FURI_LOG_I(HTTP_TAG, "%s request completed.", request->name);
+            // Stop the timer since we've completed the request
             furi_timer_stop(fhttp->get_timeout_timer);
-            fhttp->started_receiving_get = false;
-            fhttp->just_started_get = false;
+            fhttp->active_request = FlipperHTTPRequestNone;
             fhttp->state = IDLE;
             fhttp->save_bytes = false;
             fhttp->save_received_data = false;
 
-            if (fhttp->is_bytes_request)
+            // A response that lost bytes on the way in is incomplete, even though its end arrived
+            uint32_t dropped = flipper_http_update_dropped(fhttp);
+            if (dropped > 0)
             {
-                // Search for the binary marker `[GET/END]` in the file buffer
-                const char marker[] = "[GET/END]";
-                const size_t marker_len = sizeof(marker) - 1; // Exclude null terminator
-
-                for (size_t i = 0; i <= fhttp->file_buffer_len - marker_len; i++)
-                {
-                    // Check if the marker is found
-                    if (memcmp(&fhttp->file_buffer[i], marker, marker_len) == 0)
-                    {
-                        // Remove the marker by shifting the remaining data left
-                        size_t remaining_len = fhttp->file_buffer_len - (i + marker_len);
-                        memmove(&fhttp->file_buffer[i], &fhttp->file_buffer[i + marker_len], remaining_len);
-                        fhttp->file_buffer_len -= marker_len;
-                        break;
-                    }
-                }
-
-                // If there is data left in the buffer, append it to the file
-                if (fhttp->file_buffer_len > 0)
-                {
-                    if (!flipper_http_append_to_file(fhttp->file_buffer, fhttp->file_buffer_len, false, fhttp->file_path))
-                    {
-                        FURI_LOG_E(HTTP_TAG, "Failed to append data to file.");
-                    }
-                    fhttp->file_buffer_len = 0;
-                }
+                FURI_LOG_E(HTTP_TAG, "%s response lost %lu bytes.", request->name, dropped);
+            }
+            bool completed = dropped == 0;
+            if (fhttp->compressed && fhttp->sink_open && !heatshrink_stream_finished(&fhttp->inflate))
+            {
+                FURI_LOG_E(HTTP_TAG, "%s response ended inside its compressed body.", request->name);
+                completed = false;
             }
 
-            fhttp->is_bytes_request = false;
-            return;
-        }
-
-        // Append the new line to the existing data
-        if (fhttp->save_received_data &&
-            !flipper_http_append_to_file(
-                line, strlen(line), !fhttp->just_started_get, fhttp->file_path))
-        {
-            FURI_LOG_E(HTTP_TAG, "Failed to append data to file.");
-            fhttp->started_receiving_get = false;
-            fhttp->just_started_get = false;
-            fhttp->state = IDLE;
-            return;
-        }
-
-        if (!fhttp->just_started_get)
-        {
-            fhttp->just_started_get = true;
-        }
-        return;
-    }
-
-    // Check if we've started receiving data from a POST request
-    else if (fhttp->started_receiving_post)
-    {
-        // Restart the timeout timer each time new data is received
-        furi_timer_restart(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
-
-        if (strstr(line, "[POST/END]") != NULL)
-        {
-            FURI_LOG_I(HTTP_TAG, "POST request completed.");
-            // Stop the timer since we've completed the POST request
-            furi_timer_stop(fhttp->get_timeout_timer);
-            fhttp->started_receiving_post = false;
-            fhttp->just_started_post = false;
-            fhttp->state = IDLE;
-            fhttp->save_bytes = false;
-            fhttp->save_received_data = false;
-
-            if (fhttp->is_bytes_request)
+            // Remove the binary end marker from the held back bytes
+            if (!flipper_http_sink_end(fhttp, completed, request->bytes ? request->end_marker : NULL))
             {
-                // Search for the binary marker `[POST/END]` in the file buffer
-                const char marker[] = "[POST/END]";
-                const size_t marker_len = sizeof(marker) - 1; // Exclude null terminator
-
-                for (size_t i = 0; i <= fhttp->file_buffer_len - marker_len; i++)
-                {
-                    // Check if the marker is found
-                    if (memcmp(&fhttp->file_buffer[i], marker, marker_len) == 0)
-                    {
-                        // Remove the marker by shifting the remaining data left
-                        size_t remaining_len = fhttp->file_buffer_len - (i + marker_len);
-                        memmove(&fhttp->file_buffer[i], &fhttp->file_buffer[i + marker_len], remaining_len);
-                        fhttp->file_buffer_len -= marker_len;
-                        break;
-                    }
-                }
-
-                // If there is data left in the buffer, append it to the file
-                if (fhttp->file_buffer_len > 0)
-                {
-                    if (!flipper_http_append_to_file(fhttp->file_buffer, fhttp->file_buffer_len, false, fhttp->file_path))
-                    {
-                        FURI_LOG_E(HTTP_TAG, "Failed to append data to file.");
-                    }
-                    fhttp->file_buffer_len = 0;
-                }
+                FURI_LOG_E(HTTP_TAG, "Failed to append data to file.");
             }
 
             fhttp->is_bytes_request = false;
+            flipper_http_notify_complete(fhttp);
             return;
         }
 
         // Append the new line to the existing data
         if (fhttp->save_received_data &&
-            !flipper_http_append_to_file(
-                line, strlen(line), !fhttp->just_started_post, fhttp->file_path))
+            !flipper_http_sink_write(fhttp, line, strlen(line)))
         {
             FURI_LOG_E(HTTP_TAG, "Failed to append data to file.");
-            fhttp->started_receiving_post = false;
-            fhttp->just_started_post = false;
+            flipper_http_sink_end(fhttp, false, NULL);
+            fhttp->active_request = FlipperHTTPRequestNone;
             fhttp->state = IDLE;
-            return;
-        }
-
-        if (!fhttp->just_started_post)
-        {
-            fhttp->just_started_post = true;
+            flipper_http_notify_complete(fhttp);
         }
         return;
     }
 
-    // Check if we've started receiving data from a PUT request
-    else if (fhttp->started_receiving_put)
+    // Handle different types of responses
+    FlipperHTTPMarker marker = flipper_http_classify_line(line);
+
+    // Everything after [FRAME/ON] arrives in frames, so the parser switches before the rest of the chunk.
+    // The board also announces [FRAME/OFF] whenever it goes back to lines on its own.
+    if (marker == FlipperHTTPMarkerFrameOff || (fhttp->answer_pending && marker == FlipperHTTPMarkerFrameOn))
     {
-        // Restart the timeout timer each time new data is received
-        furi_timer_restart(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
+        fhttp->framed = marker == FlipperHTTPMarkerFrameOn;
+        fhttp->frame_state = FlipperHTTPFrameStateSync;
+        // Compressed bodies only travel in frames
+        fhttp->compressed = false;
+    }
+    if (fhttp->answer_pending && marker == FlipperHTTPMarkerCompressOn && fhttp->framed)
+    {
+        fhttp->compressed = true;
+    }
 
-        if (strstr(line, "[PUT/END]") != NULL)
-        {
-            FURI_LOG_I(HTTP_TAG, "PUT request completed.");
-            // Stop the timer since we've completed the PUT request
-            furi_timer_stop(fhttp->get_timeout_timer);
-            fhttp->started_receiving_put = false;
-            fhttp->just_started_put = false;
-            fhttp->state = IDLE;
-            fhttp->save_bytes = false;
-            fhttp->is_bytes_request = false;
-            fhttp->save_received_data = false;
-            return;
-        }
+    if (marker == FlipperHTTPMarkerPong)
+    {
+        fhttp->pongs++;
+    }
 
-        // Append the new line to the existing data
-        if (fhttp->save_received_data &&
-            !flipper_http_append_to_file(
-                line, strlen(line), !fhttp->just_started_put, fhttp->file_path))
+    // The first status line after a command sent with flipper_http_command is its answer
+    if (fhttp->answer_pending || marker == FlipperHTTPMarkerFrameOff)
+    {
+        fhttp->answer = marker;
+        fhttp->answer_pending = false;
+        if (fhttp->state != INACTIVE)
         {
-            FURI_LOG_E(HTTP_TAG, "Failed to append data to file.");
-            fhttp->started_receiving_put = false;
-            fhttp->just_started_put = false;
             fhttp->state = IDLE;
-            return;
-        }
-
-        if (!fhttp->just_started_put)
-        {
-            fhttp->just_started_put = true;
         }
+        flipper_http_notify_complete(fhttp);
         return;
     }
 
-    // Check if we've started receiving data from a DELETE request
-    else if (fhttp->started_receiving_delete)
+    for (FlipperHTTPRequestKind kind = FlipperHTTPRequestNone + 1; kind < FlipperHTTPRequestCount; kind++)
     {
-        // Restart the timeout timer each time new data is received
-        furi_timer_restart(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
-
-        if (strstr(line, "[DELETE/END]") != NULL)
-        {
-            FURI_LOG_I(HTTP_TAG, "DELETE request completed.");
-            // Stop the timer since we've completed the DELETE request
-            furi_timer_stop(fhttp->get_timeout_timer);
-            fhttp->started_receiving_delete = false;
-            fhttp->just_started_delete = false;
-            fhttp->state = IDLE;
-            fhttp->save_bytes = false;
-            fhttp->is_bytes_request = false;
-            fhttp->save_received_data = false;
-            return;
-        }
-
-        // Append the new line to the existing data
-        if (fhttp->save_received_data &&
-            !flipper_http_append_to_file(
-                line, strlen(line), !fhttp->just_started_delete, fhttp->file_path))
+        const FlipperHTTPRequestInfo *request = &flipper_http_requests[kind];
+        if (marker != request->success)
         {
-            FURI_LOG_E(HTTP_TAG, "Failed to append data to file.");
-            fhttp->started_receiving_delete = false;
-            fhttp->just_started_delete = false;
-            fhttp->state = IDLE;
-            return;
+            continue;
         }
-
-        if (!fhttp->just_started_delete)
+        FURI_LOG_I(HTTP_TAG, "%s request succeeded.", request->name);
+        fhttp->active_request = kind;
+        furi_timer_start(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
+        fhttp->state = RECEIVING;
+        // save bytes only if it's a bytes request
+        if (request->bytes)
         {
-            fhttp->just_started_delete = true;
+            fhttp->save_bytes = fhttp->is_bytes_request;
         }
+        flipper_http_sink_begin(fhttp);
         return;
     }
 
-    // Handle different types of responses
-    if (strstr(line, "[SUCCESS]") != NULL || strstr(line, "[CONNECTED]") != NULL)
+    switch (marker)
     {
+    case FlipperHTTPMarkerSuccess:
+    case FlipperHTTPMarkerConnected:
         FURI_LOG_I(HTTP_TAG, "Operation succeeded.");
-    }
-    else if (strstr(line, "[INFO]") != NULL)
-    {
+        break;
+    case FlipperHTTPMarkerInfo:
         FURI_LOG_I(HTTP_TAG, "Received info: %s", line);
 
         if (fhttp->state == INACTIVE && strstr(line, "[INFO] Already connected to Wifi.") != NULL)
         {
             fhttp->state = IDLE;
         }
-    }
-    else if (strstr(line, "[GET/SUCCESS]") != NULL)
-    {
-        FURI_LOG_I(HTTP_TAG, "GET request succeeded.");
-        fhttp->started_receiving_get = true;
-        furi_timer_start(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
-        fhttp->state = RECEIVING;
-        // for GET request, save data only if it's a bytes request
-        fhttp->save_bytes = fhttp->is_bytes_request;
-        fhttp->just_started_bytes = true;
-        fhttp->file_buffer_len = 0;
-        return;
-    }
-    else if (strstr(line, "[POST/SUCCESS]") != NULL)
-    {
-        FURI_LOG_I(HTTP_TAG, "POST request succeeded.");
-        fhttp->started_receiving_post = true;
-        furi_timer_start(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
-        fhttp->state = RECEIVING;
-        // for POST request, save data only if it's a bytes request
-        fhttp->save_bytes = fhttp->is_bytes_request;
-        fhttp->just_started_bytes = true;
-        fhttp->file_buffer_len = 0;
-        return;
-    }
-    else if (strstr(line, "[PUT/SUCCESS]") != NULL)
-    {
-        FURI_LOG_I(HTTP_TAG, "PUT request succeeded.");
-        fhttp->started_receiving_put = true;
-        furi_timer_start(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
-        fhttp->state = RECEIVING;
-        return;
-    }
-    else if (strstr(line, "[DELETE/SUCCESS]") != NULL)
-    {
-        FURI_LOG_I(HTTP_TAG, "DELETE request succeeded.");
-        fhttp->started_receiving_delete = true;
-        furi_timer_start(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
-        fhttp->state = RECEIVING;
-        return;
-    }
-    else if (strstr(line, "[DISCONNECTED]") != NULL)
-    {
+        break;
+    case FlipperHTTPMarkerDisconnected:
         FURI_LOG_I(HTTP_TAG, "WiFi disconnected successfully.");
-    }
-    else if (strstr(line, "[ERROR]") != NULL)
-    {
+        break;
+    case FlipperHTTPMarkerError:
         FURI_LOG_E(HTTP_TAG, "Received error: %s", line);
         fhttp->state = ISSUE;
+        flipper_http_notify_complete(fhttp);
         return;
-    }
-    else if (strstr(line, "[PONG]") != NULL)
-    {
+    case FlipperHTTPMarkerPong:
         FURI_LOG_I(HTTP_TAG, "Received PONG response: Wifi Dev Board is still alive.");
-
-        // send command to connect to WiFi
-        if (fhttp->state == INACTIVE)
-        {
-            fhttp->state = IDLE;
-            return;
-        }
+        break;
+    default:
+        break;
     }
 
-    if (fhttp->state == INACTIVE && strstr(line, "[PONG]") != NULL)
-    {
-        fhttp->state = IDLE;
-    }
-    else if (fhttp->state == INACTIVE && strstr(line, "[PONG]") == NULL)
-    {
-        fhttp->state = INACTIVE;
-    }
-    else
+    // A PONG activates the connection; any other line leaves an inactive connection inactive
+    if (fhttp->state != INACTIVE || marker == FlipperHTTPMarkerPong)
     {
         fhttp->state = IDLE;
     }
+    flipper_http_notify_complete(fhttp);
 }
 
 /**
@@ -1730,6 +2696,7 @@ bool flipper_http_process_response_async(FlipperHTTP *fhttp, bool (*http_request
         FURI_LOG_E(HTTP_TAG, "Failed to get context.");
         return false;
     }
+    furi_event_flag_clear(fhttp->events, FlipperHTTPEvtComplete);
     if (http_request()) // start the async request
     {
         furi_timer_start(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
@@ -1742,8 +2709,8 @@ bool flipper_http_process_response_async(FlipperHTTP *fhttp, bool (*http_request
     }
     while (fhttp->state == RECEIVING && furi_timer_is_running(fhttp->get_timeout_timer) > 0)
     {
-        // Wait for the request to be received
-        furi_delay_ms(100);
+        // Sleep until the response completes; the timeout only guards against a missed wake-up
+        furi_event_flag_wait(fhttp->events, FlipperHTTPEvtComplete, FuriFlagWaitAny, TIMEOUT_DURATION_TICKS);
     }
     furi_timer_stop(fhttp->get_timeout_timer);
     if (!parse_json()) // parse the JSON before switching to the view (synchonous)
@@ -13,6 +13,7 @@
 #include <furi_hal_gpio.h>
 #include <furi_hal_serial.h>
 #include <storage/storage.h>
+#include <heatshrink/heatshrink_stream.h>
 
 // STORAGE_EXT_PATH_PREFIX is defined in the Furi SDK as /ext
 
@@ -20,15 +21,38 @@
 #define http_tag "web_crawler"            // change this to your app id
 #define UART_CH (FuriHalSerialIdUsart)    // UART channel
 #define TIMEOUT_DURATION_TICKS (5 * 1000) // 5 seconds
-#define BAUDRATE (115200)                 // UART baudrate
+#define BAUDRATE (115200)                 // UART baudrate every connection starts at
+#define BAUDRATE_FAST {460800, 230400}    // Faster baudrates offered to the board, fastest first
+#define BAUD_TIMEOUT_MS 500               // Time the board has to answer [BAUD] and the PING after it
+#define PING_TIMEOUT_MS 1000              // Time the board has to answer a PING with flipper_http_ping_wait
+#define BAUD_FALLBACK_MS 1000             // Time after which a board that got no PING at the new baudrate returns to BAUDRATE
 #define RX_BUF_SIZE 2048                  // UART RX buffer size
+#define RX_BUF_HIGH_WATER 512             // Wake the worker once this many bytes are waiting
+#define RX_CHUNK_SIZE 256                 // Bytes drained from the stream buffer per read
+#define RX_THREAD_STACK_SIZE 2048         // Worker stack; sinks, parsers and their callbacks also run on it
+#define RX_FLOW_PAUSE (RX_BUF_SIZE - 512) // With flow control, pause the board once this many bytes are waiting
+#define RX_FLOW_RESUME (RX_BUF_SIZE / 4)  // With flow control, resume the board once the backlog is down to this
+#define FLOW_CONTROL_TIMEOUT_MS 1000      // Time the board has to confirm flow control
+#define FLOW_XON 0x11                     // Sent to let the board transmit again
+#define FLOW_XOFF 0x13                    // Sent to pause the board's transmission
+#define FRAME_SYNC 0xA5                   // First byte of every frame from the board in framed mode
+#define FRAME_HEADER_SIZE 3               // Frame type and little-endian payload length after FRAME_SYNC
+#define FRAME_CRC_SIZE 2                  // Little-endian CRC-16/CCITT-FALSE of header and payload after the payload
+#define FRAME_MAX_PAYLOAD 1024            // Largest frame payload (must leave room in rx_line_buffer)
+#define FRAMING_TIMEOUT_MS 1000           // Time the board has to confirm a change of framing
 #define RX_LINE_BUFFER_SIZE 4096          // UART RX line buffer size (increase for large responses)
 #define MAX_FILE_SHOW 8192                // Maximum data from file to show
-#define FILE_BUFFER_SIZE 512              // File buffer size
+#define FILE_SINK_BUFFER_SIZE 2048        // Size of each write-behind buffer for streamed responses
+#define FILE_SINK_BUFFER_COUNT 2          // Buffers a file writer's sinks fill while its thread saves the others
+#define FILE_SINK_SYNCED (1 << 8)         // Thread flag set by a file writer when a closing sink is saved
+#define BYTES_TAIL_SIZE 16                // Bytes held back from the sink until the end marker is ruled out
 
 // Forward declaration for callback
 typedef void (*FlipperHTTP_Callback)(const char *line, void *context);
 
+// Callback for when a response or status exchange finishes
+typedef void (*FlipperHTTP_CompleteCallback)(void *context);
+
 // State variable to track the UART state
 typedef enum
 {
@@ -39,13 +63,128 @@ typedef enum
     ISSUE,     // Issue with connection
 } SerialState;
 
+// Status markers that start a line from the WiFi Dev Board, e.g. "[GET/SUCCESS]"
+typedef enum
+{
+    FlipperHTTPMarkerNone,          // Not a marker line (e.g. response body)
+    FlipperHTTPMarkerSuccess,       // [SUCCESS]
+    FlipperHTTPMarkerConnected,     // [CONNECTED]
+    FlipperHTTPMarkerDisconnected,  // [DISCONNECTED]
+    FlipperHTTPMarkerInfo,          // [INFO]
+    FlipperHTTPMarkerError,         // [ERROR]
+    FlipperHTTPMarkerPong,          // [PONG]
+    FlipperHTTPMarkerGetSuccess,    // [GET/SUCCESS]
+    FlipperHTTPMarkerGetEnd,        // [GET/END]
+    FlipperHTTPMarkerPostSuccess,   // [POST/SUCCESS]
+    FlipperHTTPMarkerPostEnd,       // [POST/END]
+    FlipperHTTPMarkerPutSuccess,    // [PUT/SUCCESS]
+    FlipperHTTPMarkerPutEnd,        // [PUT/END]
+    FlipperHTTPMarkerDeleteSuccess, // [DELETE/SUCCESS]
+    FlipperHTTPMarkerDeleteEnd,     // [DELETE/END]
+    FlipperHTTPMarkerFlowOn,        // [FLOW/ON]
+    FlipperHTTPMarkerFrameOn,       // [FRAME/ON]
+    FlipperHTTPMarkerFrameOff,      // [FRAME/OFF]
+    FlipperHTTPMarkerBaudOk,        // [BAUD/OK]
+    FlipperHTTPMarkerCompressOn,    // [COMPRESS/ON]
+} FlipperHTTPMarker;
+
+// Types of the frames sent by the board in framed mode
+typedef enum
+{
+    FlipperHTTPFrameLine = 0x01, // Status line such as [GET/SUCCESS], handled like a received line
+    FlipperHTTPFrameData = 0x02, // Piece of a response body, passed to the sink as is
+} FlipperHTTPFrameType;
+
+// Progress of the frame being received in framed mode
+typedef enum
+{
+    FlipperHTTPFrameStateSync,   // Looking for FRAME_SYNC
+    FlipperHTTPFrameStateHeader, // Reading the type and length
+    FlipperHTTPFrameStateBody,   // Reading the payload and CRC
+} FlipperHTTPFrameState;
+
+// Kind of request whose response is being received
+typedef enum
+{
+    FlipperHTTPRequestNone, // No response in progress
+    FlipperHTTPRequestGet,
+    FlipperHTTPRequestPost,
+    FlipperHTTPRequestPut,
+    FlipperHTTPRequestDelete,
+    FlipperHTTPRequestCount,
+} FlipperHTTPRequestKind;
+
 // Event Flags for UART Worker Thread
 typedef enum
 {
     WorkerEvtStop = (1 << 0),
     WorkerEvtRxDone = (1 << 1),
+    WorkerEvtTimeout = (1 << 2),
+    WorkerEvtFlow = (1 << 3), // The RX backlog reached RX_FLOW_PAUSE
 } WorkerEvtFlags;
 
+// Event Flags for threads waiting on a response
+typedef enum
+{
+    FlipperHTTPEvtComplete = (1 << 0), // A response or status line was fully handled
+} FlipperHTTPEvtFlags;
+
+typedef struct FlipperHTTPFileSink FlipperHTTPFileSink;
+
+// Full buffer handed from a file sink to its writer thread
+typedef struct
+{
+    FlipperHTTPFileSink *sink; // Sink the buffer belongs to, or NULL to stop the writer
+    uint8_t *data;             // Buffer to write, or NULL once the sink's buffers are saved
+    size_t size;               // Bytes to write
+} FlipperHTTPFileSinkBlock;
+
+// Writer thread and write-behind buffers, created once and reused by every file sink opened with it
+typedef struct
+{
+    FuriThread *thread;      // Writes full buffers to their files in order
+    FuriMessageQueue *full;  // FlipperHTTPFileSinkBlock waiting for the writer
+    FuriMessageQueue *empty; // Buffers the writer has finished with
+    uint8_t *buffers;        // FILE_SINK_BUFFER_COUNT write-behind buffers
+} FlipperHTTPFileWriter;
+
+// Response sink that keeps the destination file open for the whole response
+// Full buffers are written by a writer thread, so the thread feeding the sink never waits on the SD card
+// unless every buffer is still waiting to be written
+struct FlipperHTTPFileSink
+{
+    Storage *storage;              // Storage record, held while the file is open
+    File *file;                    // Destination file
+    FlipperHTTPFileWriter *writer; // Writer saving the sink's buffers
+    uint8_t *buffer;               // Buffer being filled, NULL until the sink has data
+    size_t buffer_len;             // Bytes waiting in the buffer being filled
+    FuriThreadId closer;           // Thread waiting for FILE_SINK_SYNCED in flipper_http_file_sink_close
+    volatile bool failed;          // Set by the writer when a write fails
+};
+
+// Response sink callbacks
+typedef bool (*FlipperHTTP_SinkOpen)(void *context);
+typedef bool (*FlipperHTTP_SinkWrite)(const uint8_t *data, size_t data_size, void *context);
+typedef bool (*FlipperHTTP_SinkClose)(bool completed, void *context);
+
+// Destination of a response body
+typedef struct
+{
+    FlipperHTTP_SinkOpen open;   // Called when the response starts (optional)
+    FlipperHTTP_SinkWrite write; // Called with each piece of the body
+    FlipperHTTP_SinkClose close; // Called when the response ends or times out (optional)
+    void *context;               // Context passed to the callbacks
+} FlipperHTTPSink;
+
+// Bounded in-memory response buffer
+typedef struct
+{
+    char *data;      // Received body, always NUL-terminated
+    size_t size;     // Number of bytes stored
+    size_t capacity; // Maximum number of bytes stored
+    bool truncated;  // Set when the body did not fit
+} FlipperHTTPMemorySink;
+
 // FlipperHTTP Structure
 typedef struct
 {
@@ -56,41 +195,67 @@ typedef struct
     FlipperHTTP_Callback handle_rx_line_cb; // Callback for received lines
     void *callback_context;                 // Context for the callback
     SerialState state;                      // State of the UART
+    uint32_t baudrate;                      // Baudrate the UART runs at
 
-    // variable to store the last received data from the UART
+    // variable to store the last received status line from the UART (response bodies go to the sink)
     char *last_response;
     char file_path[256]; // Path to save the received data
 
     // Timer-related members
     FuriTimer *get_timeout_timer; // Timer for HTTP request timeout
 
-    bool started_receiving_get; // Indicates if a GET request has started
-    bool just_started_get;      // Indicates if GET data reception has just started
-
-    bool started_receiving_post; // Indicates if a POST request has started
-    bool just_started_post;      // Indicates if POST data reception has just started
-
-    bool started_receiving_put; // Indicates if a PUT request has started
-    bool just_started_put;      // Indicates if PUT data reception has just started
-
-    bool started_receiving_delete; // Indicates if a DELETE request has started
-    bool just_started_delete;      // Indicates if DELETE data reception has just started
+    FlipperHTTPRequestKind active_request; // Request whose response is being received
 
     // Buffer to hold the raw bytes received from the UART
     uint8_t *received_bytes;
     size_t received_bytes_len; // Length of the received bytes
     bool is_bytes_request;     // Flag to indicate if the request is for bytes
-    bool save_bytes;           // Flag to save the received data to a file
-    bool save_received_data;   // Flag to save the received data to a file
-
-    bool just_started_bytes; // Indicates if bytes data reception has just started
-
+    bool save_bytes;           // Flag to pass the received bytes to the sink
+    bool save_received_data;   // Flag to pass the received lines to the sink
+
+    FuriEventFlag *events;                          // Signals FlipperHTTPEvtComplete to waiting threads
+    FlipperHTTP_CompleteCallback complete_callback; // Called when a response finishes
+    void *complete_context;                         // Context for the complete callback
+    FuriMutex *tx_mutex;                            // Held while bytes are sent to the board
+
+    FlipperHTTPSink sink;               // Destination of the response body
+    bool sink_open;                     // Indicates if the sink is receiving a response
+    FlipperHTTPFileSink file_sink;      // State of the built-in file sink
+    FlipperHTTPFileWriter *file_writer; // Writer thread of the file sinks, created with the connection
+
+    uint8_t bytes_tail[BYTES_TAIL_SIZE]; // Last received bytes, held back until the end marker is ruled out
+    size_t bytes_tail_len;               // Length of the held back bytes
+
+    volatile uint32_t rx_dropped;   // Bytes lost because the stream buffer was full, since allocation
+    volatile uint32_t rx_overflows; // Times received bytes found the stream buffer full
+    uint32_t request_dropped_start; // Bytes lost before the last command was sent
+    uint32_t request_dropped;       // Bytes lost or thrown away while the last response was received
+
+    bool answer_pending;      // Indicates if the next status line answers a command sent with flipper_http_command
+    FlipperHTTPMarker answer; // Marker of that status line
+    volatile uint32_t pongs;  // PONG lines received, watched by flipper_http_ping_wait
+
+    bool flow_control;           // Indicates if the board pauses on XOFF and resumes on XON
+    volatile bool rx_paused;     // Indicates if XOFF was sent and XON is still owed, changed under tx_mutex
+    volatile uint32_t rx_pauses; // Times the board was paused
+
+    bool framed;                             // Indicates if the board sends frames instead of lines
+    FlipperHTTPFrameState frame_state;       // Progress of the frame being received
+    uint8_t frame_header[FRAME_HEADER_SIZE]; // Header of the frame being received
+    uint16_t frame_len;                      // Payload length of the frame being received
+    uint16_t frame_pos;                      // Header, or payload and CRC, bytes of the frame received so far
+    uint16_t frame_crc;                      // CRC of the header of the frame being received
+    uint32_t frame_errors;                   // Frames thrown away because their length or CRC was wrong
+    uint32_t frame_dropped;                  // Bytes of the frames thrown away
+
+    bool compressed;          // Indicates if the board compresses response bodies with heatshrink
+    HeatshrinkStream inflate; // Decodes the response body being received while compressed
+
+    uint8_t rx_chunk[RX_CHUNK_SIZE]; // Chunk drained from the stream buffer by the worker
     char rx_line_buffer[RX_LINE_BUFFER_SIZE];
-    uint8_t file_buffer[FILE_BUFFER_SIZE];
-    size_t file_buffer_len;
 } FlipperHTTP;
 
-// fhttp.last_response holds the last received data from the UART
+// fhttp.last_response holds the last received status line from the UART
 
 // Function to append received data to file
 // make sure to initialize the file path before calling this function
@@ -100,6 +265,119 @@ bool flipper_http_append_to_file(
     bool start_new_file,
     char *file_path);
 
+// Function to allocate a file writer
+/**
+ * @brief      Allocate a file writer and start its thread.
+ * @return     The file writer, or NULL on failure.
+ * @note       The writer is meant to live as long as its owner and serve every file sink the owner opens.
+ */
+FlipperHTTPFileWriter *flipper_http_file_writer_alloc(void);
+
+// Function to free a file writer
+/**
+ * @brief      Stop the writer thread and free the file writer.
+ * @return     void
+ * @param      writer  The file writer to free.
+ * @note       Every file sink opened with the writer must be closed first.
+ */
+void flipper_http_file_writer_free(FlipperHTTPFileWriter *writer);
+
+// Open the file sink, replacing any existing file at file_path
+/**
+ * @brief      Open a file sink for a streamed response.
+ * @return     true if the file was opened successfully, false otherwise.
+ * @param      sink       The file sink to open.
+ * @param      writer     The file writer that saves the sink's buffers.
+ * @param      file_path  The path of the file to write.
+ * @note       The file stays open until flipper_http_file_sink_close is called.
+ */
+bool flipper_http_file_sink_open(FlipperHTTPFileSink *sink, FlipperHTTPFileWriter *writer, const char *file_path);
+
+// Write data through the file sink's write-behind buffer
+/**
+ * @brief      Write data to an open file sink.
+ * @return     true if the data was buffered or written successfully, false otherwise.
+ * @param      sink       The file sink to write to.
+ * @param      data       The data to write.
+ * @param      data_size  The size of the data.
+ * @note       Data is handed to the writer thread once FILE_SINK_BUFFER_SIZE bytes have been buffered.
+ *             A write failure is reported by the next call after the writer hits it.
+ */
+bool flipper_http_file_sink_write(FlipperHTTPFileSink *sink, const void *data, size_t data_size);
+
+// Flush the write-behind buffer and close the file sink
+/**
+ * @brief      Flush any buffered data, wait for the writer thread to save it, and close the file sink.
+ * @return     true if all the data was written successfully, false otherwise.
+ * @param      sink  The file sink to close.
+ * @note       Safe to call on a sink that is not open. The writer thread keeps running for the next sink.
+ */
+bool flipper_http_file_sink_close(FlipperHTTPFileSink *sink);
+
+// Function to allocate a bounded in-memory response buffer
+/**
+ * @brief      Allocate a memory sink.
+ * @return     The memory sink, or NULL on failure.
+ * @param      capacity  The maximum number of bytes to keep.
+ * @note       Bytes past the capacity are dropped and the sink is marked as truncated.
+ */
+FlipperHTTPMemorySink *flipper_http_memory_sink_alloc(size_t capacity);
+
+// Function to free a memory sink
+/**
+ * @brief      Free a memory sink.
+ * @return     void
+ * @param      memory  The memory sink to free.
+ */
+void flipper_http_memory_sink_free(FlipperHTTPMemorySink *memory);
+
+// Function to set a custom response sink
+/**
+ * @brief      Send response bodies to a custom sink.
+ * @return     void
+ * @param fhttp The FlipperHTTP context
+ * @param      sink  The sink callbacks and context (copied).
+ */
+void flipper_http_set_sink(FlipperHTTP *fhttp, const FlipperHTTPSink *sink);
+
+// Function to send response bodies to fhttp->file_path
+/**
+ * @brief      Send response bodies to the file at fhttp->file_path (default).
+ * @return     void
+ * @param fhttp The FlipperHTTP context
+ */
+void flipper_http_set_sink_file(FlipperHTTP *fhttp);
+
+// Function to send response bodies to a memory sink
+/**
+ * @brief      Send response bodies to a bounded in-memory buffer.
+ * @return     void
+ * @param fhttp The FlipperHTTP context
+ * @param      memory  The memory sink to fill, it is emptied when each response starts.
+ */
+void flipper_http_set_sink_memory(FlipperHTTP *fhttp, FlipperHTTPMemorySink *memory);
+
+// Function to push response bodies into an incremental parser
+/**
+ * @brief      Send response bodies to an incremental parser as they arrive.
+ * @return     void
+ * @param fhttp The FlipperHTTP context
+ * @param      parse    The parser callback, called with each received piece of the body.
+ * @param      context  The context to pass to the parser.
+ */
+void flipper_http_set_sink_parser(FlipperHTTP *fhttp, FlipperHTTP_SinkWrite parse, void *context);
+
+// Function to be notified as soon as a response finishes
+/**
+ * @brief      Set a callback that is called as soon as a response or status line has been handled.
+ * @return     void
+ * @param fhttp The FlipperHTTP context
+ * @param      callback  The callback, called from the UART worker thread; NULL to remove it.
+ * @param      context   The context to pass to the callback.
+ * @note       Use it to post a view dispatcher event instead of polling fhttp->state.
+ */
+void flipper_http_set_complete_callback(FlipperHTTP *fhttp, FlipperHTTP_CompleteCallback callback, void *context);
+
 FuriString *flipper_http_load_from_file(char *file_path);
 FuriString *flipper_http_load_from_file_with_limit(char *file_path, size_t limit);
 
@@ -128,12 +406,15 @@ void get_timeout_timer_callback(void *context);
  * @return     void
  * @param      handle    The UART handle.
  * @param      event     The event type.
+ * @param      data_len  The number of bytes waiting in the DMA buffer.
  * @param      context   The context to pass to the callback.
  * @note       This function will handle received data asynchronously via the callback.
+ * @note       The worker is only woken on an idle line or once RX_BUF_HIGH_WATER bytes are waiting.
  */
 void _flipper_http_rx_callback(
     FuriHalSerialHandle *handle,
     FuriHalSerialRxEvent event,
+    size_t data_len,
     void *context);
 
 // UART initialization function
@@ -174,6 +455,75 @@ bool flipper_http_send_data(FlipperHTTP *fhttp, const char *data);
  */
 bool flipper_http_ping(FlipperHTTP *fhttp);
 
+// Function to ping the board and wait for its PONG
+/**
+ * @brief      Send a PING and wait for the board to answer it.
+ * @return     true if the board answered with PONG, false otherwise.
+ * @param fhttp The FlipperHTTP context
+ * @param timeout_ms The longest time to wait for the PONG.
+ * @note       Blocks until the PONG arrives or timeout_ms passes, so call it from a thread of your own,
+ *             not from a timer callback (all timers share one thread) or the GUI thread.
+ */
+bool flipper_http_ping_wait(FlipperHTTP *fhttp, uint32_t timeout_ms);
+
+// Function to negotiate a faster baud rate with the board
+/**
+ * @brief      Move the UART from BAUDRATE to the fastest rate in BAUDRATE_FAST that the board confirms.
+ * @return     true if a faster rate is in use, false if the UART stays at BAUDRATE.
+ * @param fhttp The FlipperHTTP context
+ * @note       Sends [BAUD]{"baudrate":<rate>}. The board answers [BAUD/OK] at the old rate and switches,
+ *             then the rate is checked with a PING. Without a PONG both sides return to BAUDRATE,
+ *             the board once BAUD_FALLBACK_MS pass without a PING. A refused or failed rate moves on
+ *             to the next one; no answer at all stops the negotiation.
+ * @note       Not done by flipper_http_alloc. The owner of a long-lived connection calls it once, after
+ *             flipper_http_ping_wait confirmed the board; later calls return at once. flipper_http_free
+ *             returns the board to BAUDRATE.
+ * @note       Blocks for the [BAUD/OK], the BAUD_FALLBACK_MS wait of a rejected rate and the verification
+ *             PING, which can add up to seconds. Call it from the same thread as flipper_http_ping_wait.
+ */
+bool flipper_http_negotiate_baudrate(FlipperHTTP *fhttp);
+
+// Function to turn flow control on or off
+/**
+ * @brief      Ask the board to pause when the RX stream buffer is nearly full and resume once it drains.
+ * @return     true if flow control is on when the function returns, false otherwise.
+ * @param fhttp The FlipperHTTP context
+ * @param enable true to turn flow control on, false to turn it off.
+ * @note       Sends [FLOW/ON] and blocks up to FLOW_CONTROL_TIMEOUT_MS for the board to answer [FLOW/ON].
+ *             Any other answer means the board does not support it, and nothing changes.
+ * @note       While on, a single XOFF byte pauses the board and a single XON byte resumes it.
+ *             They only travel from the Flipper to the board, so responses are never escaped.
+ */
+bool flipper_http_flow_control(FlipperHTTP *fhttp, bool enable);
+
+// Function to switch the board between lines and frames
+/**
+ * @brief      Ask the board to send frames instead of lines, so response bodies are never scanned for markers.
+ * @return     true if the board sends frames when the function returns, false otherwise.
+ * @param fhttp The FlipperHTTP context
+ * @param enable true to switch to frames, false to switch back to lines.
+ * @note       Sends [FRAME/ON] and blocks up to FRAMING_TIMEOUT_MS for the board to answer [FRAME/ON],
+ *             after which everything it sends is framed. Any other answer means the board only sends lines.
+ * @note       A frame is FRAME_SYNC, the FlipperHTTPFrameType, a 16-bit payload length, the payload and its CRC.
+ *             Status lines come as FlipperHTTPFrameLine and response bodies as FlipperHTTPFrameData.
+ * @note       [PING] puts the board back to lines, so negotiate framing after the board has answered it.
+ */
+bool flipper_http_framing(FlipperHTTP *fhttp, bool enable);
+
+// Function to turn compression of response bodies on or off
+/**
+ * @brief      Ask the board to compress response bodies, which are decoded as they arrive.
+ * @return     true if the board compresses response bodies when the function returns, false otherwise.
+ * @param fhttp The FlipperHTTP context
+ * @param enable true to turn compression on, false to turn it off.
+ * @note       Needs framing, since compressed bodies only travel in FlipperHTTPFrameData frames.
+ * @note       Sends [COMPRESS/ON]{"algorithm":"heatshrink","window":W,"lookahead":L} with the sizes of
+ *             HeatshrinkStream and waits up to FRAMING_TIMEOUT_MS for [COMPRESS/ON]. Each response body is
+ *             then a separate heatshrink stream; sinks still receive the decoded body.
+ * @note       Going back to lines, including with [PING], turns compression off.
+ */
+bool flipper_http_compression(FlipperHTTP *fhttp, bool enable);
+
 // Function to list available commands
 /**
  * @brief      Send a command to list available commands.
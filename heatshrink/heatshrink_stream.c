@@ -0,0 +1,100 @@
+#include <heatshrink/heatshrink_stream.h>
+
+#define HEATSHRINK_TAG "heatshrink_stream"
+#define WINDOW_MASK ((1 << HEATSHRINK_STREAM_WINDOW_BITS) - 1)
+
+void heatshrink_stream_reset(HeatshrinkStream *stream)
+{
+    // back-references before the first byte read zeros, as the encoder assumes
+    memset(stream, 0, sizeof(HeatshrinkStream));
+    stream->state = HeatshrinkStreamStateTag;
+}
+
+// Function to append a decoded byte to the window and the output
+static bool heatshrink_stream_emit(HeatshrinkStream *stream, uint8_t byte, HeatshrinkStreamWrite write, void *context)
+{
+    stream->window[stream->head++ & WINDOW_MASK] = byte;
+    stream->output[stream->output_len++] = byte;
+    stream->decoded++;
+    if (stream->output_len < HEATSHRINK_STREAM_OUTPUT_SIZE)
+    {
+        return true;
+    }
+    stream->output_len = 0;
+    return write(stream->output, HEATSHRINK_STREAM_OUTPUT_SIZE, context);
+}
+
+// Function to start reading the next field of the bit stream
+static void heatshrink_stream_next(HeatshrinkStream *stream, HeatshrinkStreamState state)
+{
+    stream->state = state;
+    stream->bits = 0;
+    stream->bit_count = 0;
+}
+
+bool heatshrink_stream_decode(
+    HeatshrinkStream *stream, const uint8_t *data, size_t data_size, HeatshrinkStreamWrite write, void *context)
+{
+    if (!stream || !write || (!data && data_size > 0))
+    {
+        FURI_LOG_E(HEATSHRINK_TAG, "Invalid arguments provided to heatshrink_stream_decode.");
+        return false;
+    }
+    bool success = true;
+    for (size_t i = 0; i < data_size && success; i++)
+    {
+        // fields are packed most significant bit first and do not line up with bytes
+        for (int bit = 7; bit >= 0 && success; bit--)
+        {
+            stream->bits = (stream->bits << 1) | ((data[i] >> bit) & 1);
+            stream->bit_count++;
+            switch (stream->state)
+            {
+            case HeatshrinkStreamStateTag:
+                heatshrink_stream_next(stream, stream->bits ? HeatshrinkStreamStateLiteral : HeatshrinkStreamStateIndex);
+                break;
+            case HeatshrinkStreamStateLiteral:
+                if (stream->bit_count == 8)
+                {
+                    success = heatshrink_stream_emit(stream, (uint8_t)stream->bits, write, context);
+                    heatshrink_stream_next(stream, HeatshrinkStreamStateTag);
+                }
+                break;
+            case HeatshrinkStreamStateIndex:
+                if (stream->bit_count == HEATSHRINK_STREAM_WINDOW_BITS)
+                {
+                    stream->index = stream->bits + 1;
+                    heatshrink_stream_next(stream, HeatshrinkStreamStateCount);
+                }
+                break;
+            case HeatshrinkStreamStateCount:
+                if (stream->bit_count == HEATSHRINK_STREAM_LOOKAHEAD_BITS)
+                {
+                    // the copy may overlap the bytes it produces, so it goes one byte at a time
+                    for (uint16_t count = stream->bits + 1; count > 0 && success; count--)
+                    {
+                        uint8_t byte = stream->window[(uint16_t)(stream->head - stream->index) & WINDOW_MASK];
+                        success = heatshrink_stream_emit(stream, byte, write, context);
+                    }
+                    heatshrink_stream_next(stream, HeatshrinkStreamStateTag);
+                }
+                break;
+            }
+        }
+    }
+
+    // hand on what this piece decoded instead of holding it until the next one
+    if (success && stream->output_len > 0)
+    {
+        success = write(stream->output, stream->output_len, context);
+    }
+    stream->output_len = 0;
+    return success;
+}
+
+bool heatshrink_stream_finished(const HeatshrinkStream *stream)
+{
+    // the encoder pads the last byte with zero bits, which read as the start of a back-reference
+    return stream->state == HeatshrinkStreamStateTag ||
+           (stream->state == HeatshrinkStreamStateIndex && stream->bits == 0 && 1 + stream->bit_count < 8);
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <furi.h>
+
+#define HEATSHRINK_STREAM_WINDOW_BITS 10   // log2 of the window back-references reach into (1 KB)
+#define HEATSHRINK_STREAM_LOOKAHEAD_BITS 5 // log2 of the longest back-reference (32 bytes)
+#define HEATSHRINK_STREAM_OUTPUT_SIZE 256  // Decoded bytes collected before they are handed on
+
+// Called with each piece of decoded output; returns false to stop decoding
+typedef bool (*HeatshrinkStreamWrite)(const uint8_t *data, size_t data_size, void *context);
+
+// Field of the bit stream being read
+typedef enum
+{
+    HeatshrinkStreamStateTag,     // 1 for a literal, 0 for a back-reference
+    HeatshrinkStreamStateLiteral, // 8 bits of a literal byte
+    HeatshrinkStreamStateIndex,   // Distance of a back-reference, minus 1
+    HeatshrinkStreamStateCount,   // Length of a back-reference, minus 1
+} HeatshrinkStreamState;
+
+// Incremental decoder for the heatshrink LZSS format, fed as compressed bytes arrive
+typedef struct
+{
+    HeatshrinkStreamState state;
+    uint16_t bits;                                      // Bits of the field being read
+    uint8_t bit_count;                                  // Number of bits read into the field
+    uint16_t index;                                     // Distance of the back-reference being read
+    uint16_t head;                                      // Position of the next decoded byte in the window
+    uint8_t window[1 << HEATSHRINK_STREAM_WINDOW_BITS]; // Last decoded bytes, copied by back-references
+    uint8_t output[HEATSHRINK_STREAM_OUTPUT_SIZE];      // Decoded bytes not handed on yet
+    size_t output_len;                                  // Number of bytes in output
+    size_t decoded;                                     // Bytes decoded since the last reset
+} HeatshrinkStream;
+
+/*
+ * @brief Prepare a decoder for a new compressed stream.
+ * @param stream The decoder.
+ */
+void heatshrink_stream_reset(HeatshrinkStream *stream);
+
+/*
+ * @brief Decode the next piece of a compressed stream.
+ * @param stream The decoder.
+ * @param data The compressed bytes, which may end anywhere in the stream.
+ * @param data_size The number of compressed bytes.
+ * @param write Receives the decoded bytes, in pieces of at most HEATSHRINK_STREAM_OUTPUT_SIZE.
+ * @param context Context passed to write.
+ * @return true if every decoded byte was handed on, false if write failed.
+ * @note Decoded bytes are handed on before the function returns, so nothing waits for more input.
+ */
+bool heatshrink_stream_decode(
+    HeatshrinkStream *stream, const uint8_t *data, size_t data_size, HeatshrinkStreamWrite write, void *context);
+
+/*
+ * @brief Check if a stream ended where the encoder can end it.
+ * @param stream The decoder.
+ * @return true if at most the zero bits padding the last byte are left over, false if the stream was cut off.
+ */
+bool heatshrink_stream_finished(const HeatshrinkStream *stream);
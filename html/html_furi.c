@@ -1,229 +1,333 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
+#include <ctype.h>
 #include <html/html_furi.h>
 
+#define HTML_FURI_NOT_FOUND ((size_t)-1)
+
+// A tag read from the document, e.g. <P class="x"> or </p>
+typedef struct
+{
+    const char *name;  // Start of the tag name in the document
+    size_t name_len;   // Length of the tag name
+    bool closing;      // Indicates if the tag is a closing tag
+    bool self_closing; // Indicates if the tag ends with "/>"
+    size_t end;        // Offset just after the tag's '>'
+} HTMLFuriTag;
+
 /*
- * Checks if the substring of the FuriString starting at index `pos`
- * matches the given C-string `needle`.
+ * Read the tag starting at the '<' at offset `pos`, skipping its attributes.
+ * Quotes only start an attribute value right after '=', so a stray apostrophe
+ * in an unquoted value cannot swallow the rest of the page.
+ * Returns false if `pos` does not start a well-formed tag.
  */
-static bool furi_string_sub_equals(FuriString *str, int pos, const char *needle)
+static bool html_furi_read_tag(const char *text, size_t text_len, size_t pos, HTMLFuriTag *tag)
 {
-    size_t needle_len = strlen(needle);
-    if ((size_t)pos + needle_len > furi_string_size(str))
+    size_t i = pos + 1;
+    tag->closing = i < text_len && text[i] == '/';
+    if (tag->closing)
+    {
+        i++;
+    }
+    tag->name = text + i;
+    while (i < text_len && isalnum((unsigned char)text[i]))
+    {
+        i++;
+    }
+    tag->name_len = (text + i) - tag->name;
+    if (tag->name_len == 0)
     {
         return false;
     }
-    for (size_t i = 0; i < needle_len; i++)
+
+    char quote = '\0';
+    char last = '\0'; // last character outside quotes that is not whitespace
+    for (; i < text_len; i++)
     {
-        if (furi_string_get_char(str, pos + i) != needle[i])
+        char c = text[i];
+        if (quote != '\0')
         {
-            return false;
+            if (c == quote)
+            {
+                quote = '\0';
+            }
+        }
+        else if (c == '>')
+        {
+            tag->self_closing = last == '/';
+            tag->end = i + 1;
+            return true;
+        }
+        else if ((c == '"' || c == '\'') && last == '=')
+        {
+            quote = c;
+        }
+        else if (!isspace((unsigned char)c))
+        {
+            last = c;
         }
     }
-    return true;
+    return false;
 }
 
 /*
- * Parse the content for a given HTML tag <tag> in `html`, handling nested tags.
- * Returns a newly allocated FuriString or NULL on error.
- *
- * @param tag    e.g. "<p>"
- * @param html   The HTML string to parse.
- * @param index  The position in `html` from where to start searching.
+ * Compare a tag name read from the document with `name`, ignoring case.
  */
-FuriString *html_furi_find_tag(const char *tag, FuriString *html, size_t index)
+static bool html_furi_tag_is(const HTMLFuriTag *tag, const char *name, size_t name_len)
 {
-    int tag_len = strlen(tag);
-    if (tag_len < 3)
+    if (tag->name_len != name_len)
     {
-        FURI_LOG_E("html_furi_parse", "Invalid tag length");
-        return NULL;
+        return false;
     }
-
-    // Extract the tag name from <p> => "p"
-    int inner_len = tag_len - 2; // exclude '<' and '>'
-    char inner_tag[inner_len + 1];
-    for (int i = 0; i < inner_len; i++)
+    for (size_t i = 0; i < name_len; i++)
     {
-        inner_tag[i] = tag[i + 1];
+        if (tolower((unsigned char)tag->name[i]) != tolower((unsigned char)name[i]))
+        {
+            return false;
+        }
     }
-    inner_tag[inner_len] = '\0';
-
-    // Build closing tag => "</p>"
-    char closing_tag[inner_len + 4];
-    snprintf(closing_tag, sizeof(closing_tag), "</%s>", inner_tag);
-
-    int html_len = furi_string_size(html);
+    return true;
+}
 
-    // Find the first occurrence of the opening tag
-    int open_tag_index = -1;
-    for (int i = index; i <= html_len - tag_len; i++)
+/*
+ * Find `needle` in `text` starting at offset `from`.
+ * Candidates are located with memchr on the first byte and confirmed with memcmp.
+ * Returns the offset of the match or HTML_FURI_NOT_FOUND.
+ */
+static size_t html_furi_search(const char *text, size_t text_len, size_t from, const char *needle, size_t needle_len)
+{
+    if (needle_len == 0 || needle_len > text_len)
+    {
+        return HTML_FURI_NOT_FOUND;
+    }
+    const char *end = text + text_len - needle_len + 1; // last candidate position + 1
+    const char *pos = text + from;
+    while (pos < end)
     {
-        if (furi_string_sub_equals(html, i, tag))
+        pos = memchr(pos, needle[0], end - pos);
+        if (!pos)
         {
-            open_tag_index = i;
-            break;
+            return HTML_FURI_NOT_FOUND;
         }
+        if (memcmp(pos + 1, needle + 1, needle_len - 1) == 0)
+        {
+            return pos - text;
+        }
+        pos++;
     }
-    if (open_tag_index == -1)
+    return HTML_FURI_NOT_FOUND;
+}
+
+// Elements whose content is never shown and may contain '<' that is not markup
+static const char *html_furi_raw_text_elements[] = {"script", "style", "noscript"};
+
+/*
+ * Return the name of the raw text element opened by `tag`, or NULL if it is not one.
+ */
+static const char *html_furi_raw_text_element(const HTMLFuriTag *tag)
+{
+    if (tag->closing || tag->self_closing)
     {
-        // Tag not found
         return NULL;
     }
+    for (size_t e = 0; e < COUNT_OF(html_furi_raw_text_elements); e++)
+    {
+        if (html_furi_tag_is(tag, html_furi_raw_text_elements[e], strlen(html_furi_raw_text_elements[e])))
+        {
+            return html_furi_raw_text_elements[e];
+        }
+    }
+    return NULL;
+}
 
-    // Content starts after the opening tag
-    int content_start = open_tag_index + tag_len;
-
-    // Skip leading whitespace
-    while (content_start < html_len && furi_string_get_char(html, content_start) == ' ')
+/*
+ * Find the end of a raw text element's content, i.e. its </name> closing tag.
+ * Returns the offset just after the closing tag, or `text_len` if it is missing.
+ */
+static size_t html_furi_skip_raw_text(const char *text, size_t text_len, size_t from, const char *name)
+{
+    size_t name_len = strlen(name);
+    size_t i = from;
+    HTMLFuriTag tag;
+    while (i < text_len)
     {
-        content_start++;
+        const char *next = memchr(text + i, '<', text_len - i);
+        if (!next)
+        {
+            break;
+        }
+        i = next - text;
+        if (i + 1 < text_len && text[i + 1] == '/' &&
+            html_furi_read_tag(text, text_len, i, &tag) && html_furi_tag_is(&tag, name, name_len))
+        {
+            return tag.end;
+        }
+        i++;
     }
+    return text_len;
+}
 
-    // Find matching closing tag, accounting for nested tags
-    int depth = 1;
-    int i = content_start;
-    int matching_close_index = -1;
-    while (i <= html_len - 1)
+/*
+ * Read the next tag at or after `*pos`, skipping comments and the content of
+ * <script>, <style> and <noscript> so markup-like text inside them is never matched.
+ * On success `*pos` is the offset of the tag's '<'.
+ */
+static bool html_furi_next_tag(const char *text, size_t text_len, size_t *pos, HTMLFuriTag *tag)
+{
+    size_t i = *pos;
+    while (i < text_len)
     {
-        if (furi_string_sub_equals(html, i, tag))
+        const char *next = memchr(text + i, '<', text_len - i);
+        if (!next)
         {
-            depth++;
-            i += tag_len;
-            continue;
+            break;
         }
-        if (furi_string_sub_equals(html, i, closing_tag))
+        i = next - text;
+        if (i + 4 <= text_len && memcmp(text + i, "<!--", 4) == 0)
         {
-            depth--;
-            if (depth == 0)
+            // Skip to the end of the comment
+            size_t end = html_furi_search(text, text_len, i + 4, "-->", 3);
+            if (end == HTML_FURI_NOT_FOUND)
             {
-                matching_close_index = i;
                 break;
             }
-            i += strlen(closing_tag);
+            i = end + 3;
             continue;
         }
-        i++;
-    }
-
-    if (matching_close_index == -1)
-    {
-        // No matching close => return NULL or partial content as you choose
-        return NULL;
-    }
-
-    // Copy the content between <tag>...</tag>
-    size_t content_length = matching_close_index - content_start;
-
-    if (memmgr_get_free_heap() < (content_length + 1 + 1024))
-    {
-        FURI_LOG_E("html_furi_parse", "Not enough heap to allocate result");
-        return NULL;
+        if (!html_furi_read_tag(text, text_len, i, tag))
+        {
+            i++;
+            continue;
+        }
+        const char *raw = html_furi_raw_text_element(tag);
+        if (raw)
+        {
+            i = html_furi_skip_raw_text(text, text_len, tag->end, raw);
+            continue;
+        }
+        *pos = i;
+        return true;
     }
-
-    // Allocate and copy
-    FuriString *result = furi_string_alloc();
-    furi_string_reserve(result, content_length + 1);
-    furi_string_set_n(result, html, content_start, content_length);
-    furi_string_trim(result);
-    return result;
+    *pos = text_len;
+    return false;
 }
 
-static FuriString *_html_furi_find_tag(const char *tag, FuriString *html, size_t index, int *out_next_index)
+/*
+ * Find the next opening tag called `name` at or after `from`.
+ * Candidates are located with memchr on '<' and every tag is read only once.
+ * Returns the offset of the tag's '<' or HTML_FURI_NOT_FOUND.
+ */
+static size_t html_furi_find_open(const char *text, size_t text_len, size_t from, const char *name, size_t name_len, HTMLFuriTag *tag)
 {
-    // Clear next index in case of early return
-    *out_next_index = -1;
-
-    int tag_len = strlen(tag);
-    if (tag_len < 3)
+    size_t i = from;
+    while (html_furi_next_tag(text, text_len, &i, tag))
     {
-        FURI_LOG_E("html_furi_parse", "Invalid tag length");
-        return NULL;
-    }
-
-    // Extract "p" from "<p>"
-    int inner_len = tag_len - 2;
-    char inner_tag[inner_len + 1];
-    for (int i = 0; i < inner_len; i++)
-    {
-        inner_tag[i] = tag[i + 1];
+        if (!tag->closing && html_furi_tag_is(tag, name, name_len))
+        {
+            return i;
+        }
+        i = tag->end;
     }
-    inner_tag[inner_len] = '\0';
-
-    // Create closing tag => "</p>"
-    char closing_tag[inner_len + 4];
-    snprintf(closing_tag, sizeof(closing_tag), "</%s>", inner_tag);
+    return HTML_FURI_NOT_FOUND;
+}
 
-    int html_len = furi_string_size(html);
+/*
+ * Locate the content of the first <tag> at or after `index`, handling nested tags.
+ * Tags match regardless of case and attributes; self-closing tags have no content.
+ *
+ * @param out_start  Offset of the content, after leading spaces.
+ * @param out_end    Offset of the matching closing tag.
+ * @param out_next   Offset just after the matching closing tag.
+ * @return true if both the opening and the matching closing tag were found.
+ */
+static bool html_furi_find_span(const char *tag, const char *text, size_t text_len, size_t index, size_t *out_start, size_t *out_end, size_t *out_next)
+{
+    // Extract the tag name from <p> => "p"
+    const char *name = tag + 1;
+    size_t name_len = strlen(tag) - 2;
 
-    // 1) Find opening tag from `index`.
-    int open_tag_index = -1;
-    for (int i = index; i <= html_len - tag_len; i++)
+    // Find the first occurrence of the opening tag that can have content
+    HTMLFuriTag found;
+    size_t open_tag_index = index;
+    do
     {
-        if (furi_string_sub_equals(html, i, tag))
+        open_tag_index = html_furi_find_open(text, text_len, open_tag_index, name, name_len, &found);
+        if (open_tag_index == HTML_FURI_NOT_FOUND)
         {
-            open_tag_index = i;
-            break;
+            return false;
         }
-    }
-    if (open_tag_index == -1)
-    {
-        return NULL; // no more occurrences
-    }
-
-    // The content begins after the opening tag.
-    int content_start = open_tag_index + tag_len;
+        open_tag_index = found.end;
+    } while (found.self_closing);
 
-    // skip leading spaces
-    while (content_start < html_len && furi_string_get_char(html, content_start) == ' ')
+    // Content starts after the opening tag, skipping leading whitespace
+    size_t content_start = found.end;
+    while (content_start < text_len && text[content_start] == ' ')
     {
         content_start++;
     }
 
-    int depth = 1;
-    int i = content_start;
-    int matching_close_index = -1;
-
-    while (i < html_len)
+    // Find matching closing tag, accounting for nested tags
+    size_t depth = 1;
+    size_t i = content_start;
+    while (html_furi_next_tag(text, text_len, &i, &found))
     {
-        if (furi_string_sub_equals(html, i, tag))
-        {
-            depth++;
-            i += tag_len;
-        }
-        else if (furi_string_sub_equals(html, i, closing_tag))
+        if (html_furi_tag_is(&found, name, name_len))
         {
-            depth--;
-            i += strlen(closing_tag);
-            if (depth == 0)
+            if (found.closing && --depth == 0)
             {
-                matching_close_index = i - strlen(closing_tag);
-                // i now points just after "</p>"
-                break;
+                *out_start = content_start;
+                *out_end = i;
+                *out_next = found.end;
+                return true;
+            }
+            if (!found.closing && !found.self_closing)
+            {
+                depth++;
             }
         }
-        else
-        {
-            i++;
-        }
+        i = found.end;
+    }
+    return false;
+}
+
+/*
+ * Parse the content for a given HTML tag <tag> in `html`, handling nested tags.
+ * Returns a newly allocated FuriString or NULL on error.
+ *
+ * @param tag    e.g. "<p>"
+ * @param html   The HTML string to parse.
+ * @param index  The position in `html` from where to start searching.
+ */
+FuriString *html_furi_find_tag(const char *tag, FuriString *html, size_t index)
+{
+    if (strlen(tag) < 3)
+    {
+        FURI_LOG_E("html_furi_parse", "Invalid tag length");
+        return NULL;
     }
 
-    if (matching_close_index == -1)
+    size_t content_start, matching_close_index, next_index;
+    if (!html_furi_find_span(tag, furi_string_get_cstr(html), furi_string_size(html), index, &content_start, &matching_close_index, &next_index))
     {
-        // No matching close tag found
+        // Tag not found, or no matching close
         return NULL;
     }
 
+    // Copy the content between <tag>...</tag>
     size_t content_length = matching_close_index - content_start;
 
-    // Allocate the result
+    if (memmgr_get_free_heap() < (content_length + 1 + 1024))
+    {
+        FURI_LOG_E("html_furi_parse", "Not enough heap to allocate result");
+        return NULL;
+    }
+
+    // Allocate and copy
     FuriString *result = furi_string_alloc();
-    furi_string_reserve(result, content_length + 1); // +1 for safety
+    furi_string_reserve(result, content_length + 1);
     furi_string_set_n(result, html, content_start, content_length);
     furi_string_trim(result);
-    *out_next_index = i;
-
     return result;
 }
 
@@ -234,26 +338,29 @@ static FuriString *_html_furi_find_tag(const char *tag, FuriString *html, size_t
 FuriString *html_furi_find_tags(const char *tag, FuriString *html)
 {
     FuriString *result = furi_string_alloc();
-    size_t index = 0;
-
-    while (true)
+    if (strlen(tag) < 3)
     {
-        int next_index;
-        FuriString *parsed = _html_furi_find_tag(tag, html, index, &next_index);
-        if (parsed == NULL)
-        {
-            // No more tags from 'index' onward
-            break;
-        }
+        FURI_LOG_E("html_furi_parse", "Invalid tag length");
+        return result;
+    }
 
+    const char *text = furi_string_get_cstr(html);
+    size_t text_len = furi_string_size(html);
+    FuriString *parsed = furi_string_alloc();
+    size_t index = 0;
+    size_t content_start, matching_close_index, next_index;
+    while (html_furi_find_span(tag, text, text_len, index, &content_start, &matching_close_index, &next_index))
+    {
         // Append the found content
+        furi_string_set_n(parsed, html, content_start, matching_close_index - content_start);
+        furi_string_trim(parsed);
         furi_string_cat(result, parsed);
         furi_string_cat_str(result, "\n");
-        furi_string_free(parsed);
 
-        // Resume searching at `next_index` (just after `</tag>`).
+        // Resume searching just after `</tag>`
         index = next_index;
     }
+    furi_string_free(parsed);
 
     return result;
 }
@@ -267,22 +374,268 @@ FuriString *html_furi_find_tags(const char *tag, FuriString *html)
  */
 bool html_furi_tag_exists(const char *tag, FuriString *html, size_t index)
 {
-    int tag_len = strlen(tag);
+    size_t tag_len = strlen(tag);
     if (tag_len < 3)
     {
         FURI_LOG_E("html_furi_parse", "Invalid tag length");
         return false;
     }
 
-    int html_len = furi_string_size(html);
+    HTMLFuriTag found;
+    return html_furi_find_open(furi_string_get_cstr(html), furi_string_size(html), index, tag + 1, tag_len - 2, &found) != HTML_FURI_NOT_FOUND;
+}
+
+/*
+ * Find every occurrence of several HTML tags in a single traversal of `html`.
+ * Each tag in the document is read once and compared against every requested name.
+ * Matches are recorded when their closing tag is reached, then sorted by position.
+ */
+size_t html_furi_extract(const char **tags, size_t tag_count, FuriString *html, HTMLFuriMatch *matches, size_t max_matches)
+{
+    if (tag_count == 0 || tag_count > HTML_FURI_MAX_TAGS)
+    {
+        FURI_LOG_E("html_furi_parse", "Invalid tag count");
+        return 0;
+    }
 
-    for (int i = index; i <= html_len - tag_len; i++)
+    size_t tag_lens[HTML_FURI_MAX_TAGS];
+    size_t depth[HTML_FURI_MAX_TAGS];
+    size_t content_start[HTML_FURI_MAX_TAGS];
+    for (size_t t = 0; t < tag_count; t++)
     {
-        if (furi_string_sub_equals(html, i, tag))
+        tag_lens[t] = strlen(tags[t]);
+        if (tag_lens[t] < 3 || tag_lens[t] > HTML_FURI_MAX_TAG_SIZE)
         {
-            return true;
+            FURI_LOG_E("html_furi_parse", "Invalid tag length");
+            return 0;
         }
+        depth[t] = 0;
+        content_start[t] = 0;
     }
 
-    return false;
-}
\ No newline at end of file
+    size_t match_count = 0;
+    const char *text = furi_string_get_cstr(html);
+    size_t html_len = furi_string_size(html);
+    size_t i = 0;
+    HTMLFuriTag found;
+    while (match_count < max_matches && html_furi_next_tag(text, html_len, &i, &found))
+    {
+        for (size_t t = 0; t < tag_count; t++)
+        {
+            if (!html_furi_tag_is(&found, tags[t] + 1, tag_lens[t] - 2))
+            {
+                continue;
+            }
+            if (!found.closing && !found.self_closing)
+            {
+                if (depth[t]++ == 0)
+                {
+                    content_start[t] = found.end;
+                }
+            }
+            else if (found.closing && depth[t] > 0 && --depth[t] == 0)
+            {
+                matches[match_count].tag_index = t;
+                matches[match_count].start = content_start[t];
+                matches[match_count].length = i - content_start[t];
+                match_count++;
+            }
+            break;
+        }
+        i = found.end;
+    }
+
+    // Matches were recorded at their closing tag; order them by where they start
+    for (size_t m = 1; m < match_count; m++)
+    {
+        HTMLFuriMatch match = matches[m];
+        size_t n = m;
+        while (n > 0 && matches[n - 1].start > match.start)
+        {
+            matches[n] = matches[n - 1];
+            n--;
+        }
+        matches[n] = match;
+    }
+    return match_count;
+}
+
+// Named entities that are common in page text, with ASCII replacements the Flipper fonts can draw
+static const struct
+{
+    const char *name;
+    const char *text;
+} html_furi_entities[] = {
+    {"amp", "&"},
+    {"lt", "<"},
+    {"gt", ">"},
+    {"quot", "\""},
+    {"apos", "'"},
+    {"nbsp", " "},
+    {"ndash", "-"},
+    {"mdash", "-"},
+    {"hellip", "..."},
+    {"lsquo", "'"},
+    {"rsquo", "'"},
+    {"ldquo", "\""},
+    {"rdquo", "\""},
+    {"laquo", "<<"},
+    {"raquo", ">>"},
+    {"bull", "*"},
+    {"middot", "."},
+    {"copy", "(c)"},
+    {"reg", "(R)"},
+    {"trade", "TM"},
+};
+
+/*
+ * Map a numeric character reference to ASCII text.
+ */
+static size_t html_furi_decode_code_point(unsigned long code, char *out)
+{
+    if (code > 0 && code < 0x80)
+    {
+        out[0] = (char)code;
+        return 1;
+    }
+    const char *text;
+    switch (code)
+    {
+    case 0xA0: // no-break space
+        text = " ";
+        break;
+    case 0x2013: // en dash
+    case 0x2014: // em dash
+        text = "-";
+        break;
+    case 0x2018: // quotation marks
+    case 0x2019:
+    case 0x201A:
+    case 0x201B:
+        text = "'";
+        break;
+    case 0x201C:
+    case 0x201D:
+    case 0x201E:
+    case 0x201F:
+        text = "\"";
+        break;
+    case 0x2022: // bullet
+        text = "*";
+        break;
+    case 0x2026: // ellipsis
+        text = "...";
+        break;
+    default:
+        text = "?";
+        break;
+    }
+    size_t len = strlen(text);
+    memcpy(out, text, len);
+    return len;
+}
+
+size_t html_furi_decode_entity(const char *name, size_t name_len, char *out)
+{
+    if (name_len >= 2 && name[0] == '#')
+    {
+        // Numeric reference => &#8217; or &#x2019;
+        bool hex = name[1] == 'x' || name[1] == 'X';
+        size_t i = hex ? 2 : 1;
+        if (i == name_len)
+        {
+            return 0;
+        }
+        unsigned long code = 0;
+        for (; i < name_len; i++)
+        {
+            char c = name[i];
+            int digit;
+            if (isdigit((unsigned char)c))
+            {
+                digit = c - '0';
+            }
+            else if (hex && isxdigit((unsigned char)c))
+            {
+                digit = tolower((unsigned char)c) - 'a' + 10;
+            }
+            else
+            {
+                return 0;
+            }
+            code = code * (hex ? 16 : 10) + digit;
+            if (code > 0x10FFFF)
+            {
+                return 0;
+            }
+        }
+        return html_furi_decode_code_point(code, out);
+    }
+
+    for (size_t e = 0; e < COUNT_OF(html_furi_entities); e++)
+    {
+        if (strlen(html_furi_entities[e].name) == name_len &&
+            memcmp(html_furi_entities[e].name, name, name_len) == 0)
+        {
+            size_t len = strlen(html_furi_entities[e].text);
+            memcpy(out, html_furi_entities[e].text, len);
+            return len;
+        }
+    }
+    return 0;
+}
+
+size_t html_furi_normalize(char *text, size_t text_len)
+{
+    // Decoded text is never longer than its source, so the write position can trail the read position
+    size_t write = 0;
+    char decoded[HTML_FURI_ENTITY_TEXT_SIZE];
+    for (size_t read = 0; read < text_len; read++)
+    {
+        const char *chars = &text[read];
+        size_t count = 1;
+        if (text[read] == '&')
+        {
+            const char *semicolon = memchr(&text[read + 1], ';', MIN(text_len - read - 1, (size_t)HTML_FURI_ENTITY_SIZE + 1));
+            if (semicolon)
+            {
+                size_t name_len = semicolon - &text[read + 1];
+                size_t decoded_len = html_furi_decode_entity(&text[read + 1], name_len, decoded);
+                if (decoded_len > 0)
+                {
+                    chars = decoded;
+                    count = decoded_len;
+                    read += name_len + 1;
+                }
+            }
+        }
+        for (size_t i = 0; i < count; i++)
+        {
+            char c = chars[i];
+            if (isspace((unsigned char)c))
+            {
+                // Collapse whitespace runs into one space and drop leading whitespace
+                if (write == 0 || text[write - 1] == ' ')
+                {
+                    continue;
+                }
+                c = ' ';
+            }
+            text[write++] = c;
+        }
+    }
+    // Drop trailing whitespace
+    while (write > 0 && text[write - 1] == ' ')
+    {
+        write--;
+    }
+    text[write] = '\0';
+    return write;
+}
+
+void html_furi_normalize_string(FuriString *str)
+{
+    // Normalizing only shrinks the text, so it can be done in the string's own buffer
+    char *text = (char *)furi_string_get_cstr(str);
+    furi_string_left(str, html_furi_normalize(text, furi_string_size(str)));
+}
@@ -2,6 +2,19 @@
 #include <furi.h>
 #include <furi_hal.h>
 
+#define HTML_FURI_MAX_TAGS 8         // Maximum number of tags html_furi_extract can search for at once
+#define HTML_FURI_MAX_TAG_SIZE 16    // Maximum length of a tag passed to html_furi_extract
+#define HTML_FURI_ENTITY_SIZE 8      // Longest entity name decoded, e.g. "#x1F600"
+#define HTML_FURI_ENTITY_TEXT_SIZE 3 // Longest text an entity decodes to, e.g. "..."
+
+// A tag occurrence found by html_furi_extract
+typedef struct
+{
+    size_t tag_index; // Index of the tag in the tags array
+    size_t start;     // Offset of the content, just after the opening tag
+    size_t length;    // Length of the content, up to the matching closing tag
+} HTMLFuriMatch;
+
 /*
  * @brief Parse a Furigana string from an HTML tag, handling nested child tags.
  *
@@ -14,6 +27,9 @@
  * and searching with tag "<p>" the function will return:
  *     "<h1><p><h1>Test</h1></p></h1>"
  *
+ * Tag names are matched regardless of case and attributes, so "<p>" also
+ * matches <P> and <p class="x">. Self-closing tags such as <p/> have no content.
+ *
  * @param tag The HTML tag to parse (including the angle brackets).
  * @param html The HTML string to parse (as a FuriString).
  * @return A newly allocated FuriString containing the parsed content,
@@ -37,4 +53,54 @@ FuriString *html_furi_find_tags(const char *tag, FuriString *html);
  * @param index The starting index to search from.
  * @return True if the tag exists in the HTML string, false otherwise.
  */
-bool html_furi_tag_exists(const char *tag, FuriString *html, size_t index);
\ No newline at end of file
+bool html_furi_tag_exists(const char *tag, FuriString *html, size_t index);
+
+/*
+ * @brief Find every occurrence of several HTML tags in a single pass.
+ *
+ * Each tag is matched with its closing tag, taking nested occurrences of the
+ * same tag into account. Like html_furi_find_tag, matching ignores case and
+ * attributes. For example, searching "<html><p>A</p><h1>B</h1></html>"
+ * for {"<p>", "<h1>"} returns two matches: tag 0 with content "A" and tag 1 with
+ * content "B".
+ *
+ * @param tags The HTML tags to search for (including the angle brackets).
+ * @param tag_count The number of tags (at most HTML_FURI_MAX_TAGS).
+ * @param html The HTML string to search (as a FuriString).
+ * @param matches Array that receives the matches, ordered by position in the document.
+ * @param max_matches The size of the matches array; scanning stops once it is full.
+ * @return The number of matches written to `matches`.
+ */
+size_t html_furi_extract(const char **tags, size_t tag_count, FuriString *html, HTMLFuriMatch *matches, size_t max_matches);
+
+/*
+ * @brief Decode an HTML entity to ASCII text.
+ *
+ * Common named entities and numeric references are supported. Typographic
+ * characters such as curly quotes and dashes are replaced by their ASCII
+ * equivalents; other non-ASCII characters become '?'.
+ *
+ * @param name The entity name between '&' and ';' (e.g. "amp" or "#8217").
+ * @param name_len The length of the entity name.
+ * @param out Buffer of at least HTML_FURI_ENTITY_TEXT_SIZE characters that receives the text.
+ * @return The number of characters written to `out`, or 0 if the entity is unknown.
+ */
+size_t html_furi_decode_entity(const char *name, size_t name_len, char *out);
+
+/*
+ * @brief Decode entities and collapse whitespace in place.
+ *
+ * Runs of whitespace become a single space, and leading and trailing
+ * whitespace is removed. The text never grows, so no allocation is needed.
+ *
+ * @param text The text to normalize; it is NUL-terminated afterwards.
+ * @param text_len The length of the text.
+ * @return The new length of the text.
+ */
+size_t html_furi_normalize(char *text, size_t text_len);
+
+/*
+ * @brief Decode entities and collapse whitespace in a FuriString in place.
+ * @param str The string to normalize.
+ */
+void html_furi_normalize_string(FuriString *str);
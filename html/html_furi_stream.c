@@ -0,0 +1,606 @@
+#include <string.h>
+#include <ctype.h>
+#include <html/html_furi_stream.h>
+
+/*
+ * Map a tag name to the element it extracts, if any.
+ */
+static HTMLFuriStreamCapture html_furi_stream_capture_for(const char *tag)
+{
+    if (strcmp(tag, "p") == 0)
+    {
+        return HTMLFuriStreamCaptureP;
+    }
+    if (strcmp(tag, "h1") == 0)
+    {
+        return HTMLFuriStreamCaptureH1;
+    }
+    if (strcmp(tag, "h2") == 0)
+    {
+        return HTMLFuriStreamCaptureH2;
+    }
+    if (strcmp(tag, "h3") == 0)
+    {
+        return HTMLFuriStreamCaptureH3;
+    }
+    if (strcmp(tag, "title") == 0)
+    {
+        return HTMLFuriStreamCaptureTitle;
+    }
+    return HTMLFuriStreamCaptureNone;
+}
+
+/*
+ * Return the name of the raw text element opened by a tag, or NULL if it is not one.
+ * The content of these elements is never shown and may contain '<' that is not markup.
+ */
+static const char *html_furi_stream_raw_text_for(const char *tag)
+{
+    static const char *elements[] = {"script", "style", "noscript"};
+    for (size_t e = 0; e < COUNT_OF(elements); e++)
+    {
+        if (strcmp(tag, elements[e]) == 0)
+        {
+            return elements[e];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Append a string to the output, marking the output as truncated once it is full.
+ */
+static void html_furi_stream_emit(HTMLFuriStream *stream, const char *text, size_t len)
+{
+    size_t space = stream->output_capacity - stream->output_len;
+    if (len > space)
+    {
+        stream->truncated = true;
+        len = space;
+    }
+    memcpy(&stream->output[stream->output_len], text, len);
+    stream->output_len += len;
+    stream->output[stream->output_len] = '\0';
+}
+
+/*
+ * Append a character of element text, collapsing runs of whitespace into one space
+ * and skipping whitespace at the start of the element.
+ */
+static void html_furi_stream_emit_char(HTMLFuriStream *stream, char c)
+{
+    if (isspace((unsigned char)c))
+    {
+        if (stream->output_len == stream->capture_start || stream->output[stream->output_len - 1] == ' ')
+        {
+            return;
+        }
+        c = ' ';
+    }
+    html_furi_stream_emit(stream, &c, 1);
+}
+
+/*
+ * Emit the entity read so far, decoded if it is complete and known, otherwise as it appeared.
+ */
+static void html_furi_stream_end_entity(HTMLFuriStream *stream, bool terminated)
+{
+    char decoded[HTML_FURI_ENTITY_TEXT_SIZE];
+    size_t decoded_len = terminated ? html_furi_decode_entity(stream->entity, stream->entity_len, decoded) : 0;
+    if (decoded_len > 0)
+    {
+        for (size_t i = 0; i < decoded_len; i++)
+        {
+            html_furi_stream_emit_char(stream, decoded[i]);
+        }
+    }
+    else
+    {
+        html_furi_stream_emit_char(stream, '&');
+        for (size_t i = 0; i < stream->entity_len; i++)
+        {
+            html_furi_stream_emit_char(stream, stream->entity[i]);
+        }
+        if (terminated)
+        {
+            html_furi_stream_emit_char(stream, ';');
+        }
+    }
+    stream->in_entity = false;
+    stream->entity_len = 0;
+}
+
+static void html_furi_stream_start_capture(HTMLFuriStream *stream, HTMLFuriStreamCapture capture)
+{
+    stream->capture = capture;
+    stream->capture_depth = 1;
+    stream->capture_prefix_start = stream->output_len;
+    if (capture == HTMLFuriStreamCaptureTitle)
+    {
+        html_furi_stream_emit(stream, "Title: ", 7);
+    }
+    stream->capture_start = stream->output_len;
+}
+
+static void html_furi_stream_end_capture(HTMLFuriStream *stream)
+{
+    // Trim trailing whitespace, and drop the element entirely if it had no text
+    while (stream->output_len > stream->capture_start &&
+           isspace((unsigned char)stream->output[stream->output_len - 1]))
+    {
+        stream->output_len--;
+    }
+    if (stream->output_len == stream->capture_start)
+    {
+        stream->output_len = stream->capture_prefix_start;
+    }
+    else if (stream->capture == HTMLFuriStreamCaptureTitle || stream->capture == HTMLFuriStreamCaptureH1)
+    {
+        html_furi_stream_emit(stream, "\n\n", 2);
+    }
+    else
+    {
+        html_furi_stream_emit(stream, "\n", 1);
+    }
+    stream->output[stream->output_len] = '\0';
+    stream->capture = HTMLFuriStreamCaptureNone;
+    stream->capture_depth = 0;
+}
+
+/*
+ * Finish the attribute value being read in a link tag, reporting it if it is the href.
+ */
+static void html_furi_stream_end_attribute(HTMLFuriStream *stream)
+{
+    if (stream->in_href && !stream->href_overflow && stream->href_len > 0)
+    {
+        stream->href[stream->href_len] = '\0';
+        stream->link_callback(stream->href, stream->link_context);
+    }
+    stream->attribute_len = 0;
+    stream->attribute_done = false;
+    stream->value_unquoted = false;
+    stream->in_href = false;
+}
+
+/*
+ * Append a character to the href being read.
+ */
+static void html_furi_stream_href_char(HTMLFuriStream *stream, char c)
+{
+    if (stream->href_len < HTML_FURI_STREAM_HREF_SIZE)
+    {
+        stream->href[stream->href_len++] = c;
+    }
+    else
+    {
+        stream->href_overflow = true;
+    }
+}
+
+/*
+ * Start an attribute value, which is captured if it belongs to the href attribute.
+ */
+static void html_furi_stream_start_value(HTMLFuriStream *stream)
+{
+    stream->in_href = stream->attribute_len == 4 && memcmp(stream->attribute, "href", 4) == 0;
+    stream->href_len = 0;
+    stream->href_overflow = false;
+}
+
+/*
+ * Track the attributes of a link tag, one character at a time. This runs before the
+ * generic TagRest handling, so quote and tag_last still describe the previous character.
+ */
+static void html_furi_stream_link_char(HTMLFuriStream *stream, char c)
+{
+    if (stream->quote != '\0')
+    {
+        if (c == stream->quote)
+        {
+            html_furi_stream_end_attribute(stream);
+        }
+        else if (stream->in_href)
+        {
+            html_furi_stream_href_char(stream, c);
+        }
+    }
+    else if (c == '>' || isspace((unsigned char)c))
+    {
+        if (stream->value_unquoted)
+        {
+            html_furi_stream_end_attribute(stream);
+        }
+        else if (stream->attribute_len > 0)
+        {
+            stream->attribute_done = true;
+        }
+    }
+    else if ((c == '"' || c == '\'') && stream->tag_last == '=')
+    {
+        html_furi_stream_start_value(stream);
+    }
+    else if (c == '=' || stream->value_unquoted)
+    {
+        if (stream->in_href)
+        {
+            html_furi_stream_href_char(stream, c);
+        }
+    }
+    else if (stream->tag_last == '=')
+    {
+        // An unquoted value such as href=/about
+        html_furi_stream_start_value(stream);
+        stream->value_unquoted = true;
+        if (stream->in_href)
+        {
+            html_furi_stream_href_char(stream, c);
+        }
+    }
+    else
+    {
+        if (stream->attribute_done)
+        {
+            // The previous attribute had no value
+            stream->attribute_len = 0;
+            stream->attribute_done = false;
+        }
+        if (stream->attribute_len < HTML_FURI_STREAM_TAG_SIZE)
+        {
+            stream->attribute[stream->attribute_len++] = tolower((unsigned char)c);
+        }
+    }
+}
+
+/*
+ * Update the extraction state once a complete tag has been read.
+ */
+static void html_furi_stream_handle_tag(HTMLFuriStream *stream)
+{
+    if (!stream->tag_closing && strcmp(stream->tag, "head") == 0)
+    {
+        stream->head_found = true;
+    }
+    if (!stream->tag_closing && !stream->tag_self_closing)
+    {
+        stream->raw_text = html_furi_stream_raw_text_for(stream->tag);
+        if (stream->raw_text)
+        {
+            stream->raw_match = 0;
+            stream->state = HTMLFuriStreamStateRawText;
+            return;
+        }
+    }
+
+    HTMLFuriStreamCapture capture = html_furi_stream_capture_for(stream->tag);
+    if (capture == HTMLFuriStreamCaptureNone || stream->tag_self_closing)
+    {
+        // Self-closing forms such as <p/> have no content
+        return;
+    }
+    if (!stream->tag_closing)
+    {
+        if (stream->capture == HTMLFuriStreamCaptureNone)
+        {
+            html_furi_stream_start_capture(stream, capture);
+        }
+        else if (stream->capture == capture)
+        {
+            stream->capture_depth++;
+        }
+    }
+    else if (stream->capture == capture && --stream->capture_depth == 0)
+    {
+        html_furi_stream_end_capture(stream);
+    }
+}
+
+HTMLFuriStream *html_furi_stream_alloc(size_t max_output)
+{
+    HTMLFuriStream *stream = (HTMLFuriStream *)malloc(sizeof(HTMLFuriStream));
+    if (!stream)
+    {
+        FURI_LOG_E("html_furi_stream", "Failed to allocate stream parser");
+        return NULL;
+    }
+    stream->output = (char *)malloc(max_output + 1);
+    if (!stream->output)
+    {
+        FURI_LOG_E("html_furi_stream", "Failed to allocate stream output");
+        free(stream);
+        return NULL;
+    }
+    stream->output_capacity = max_output;
+    stream->link_callback = NULL;
+    stream->link_context = NULL;
+    html_furi_stream_reset(stream);
+    return stream;
+}
+
+void html_furi_stream_free(HTMLFuriStream *stream)
+{
+    if (!stream)
+    {
+        return;
+    }
+    free(stream->output);
+    free(stream);
+}
+
+void html_furi_stream_reset(HTMLFuriStream *stream)
+{
+    stream->state = HTMLFuriStreamStateText;
+    stream->tag_len = 0;
+    stream->tag_closing = false;
+    stream->tag_self_closing = false;
+    stream->quote = '\0';
+    stream->tag_last = '\0';
+    stream->dashes = 0;
+    stream->raw_text = NULL;
+    stream->raw_match = 0;
+    stream->link_tag = false;
+    stream->attribute_len = 0;
+    stream->attribute_done = false;
+    stream->value_unquoted = false;
+    stream->in_href = false;
+    stream->href_len = 0;
+    stream->href_overflow = false;
+    stream->entity_len = 0;
+    stream->in_entity = false;
+    stream->capture = HTMLFuriStreamCaptureNone;
+    stream->capture_depth = 0;
+    stream->capture_prefix_start = 0;
+    stream->capture_start = 0;
+    stream->head_found = false;
+    stream->output_len = 0;
+    stream->output[0] = '\0';
+    stream->truncated = false;
+}
+
+bool html_furi_stream_feed(const uint8_t *data, size_t data_size, void *context)
+{
+    HTMLFuriStream *stream = (HTMLFuriStream *)context;
+    const char *text = (const char *)data;
+    size_t i = 0;
+    while (i < data_size)
+    {
+        char c = text[i];
+        switch (stream->state)
+        {
+        case HTMLFuriStreamStateText:
+            if (stream->in_entity)
+            {
+                if (c == ';')
+                {
+                    html_furi_stream_end_entity(stream, true);
+                    break;
+                }
+                if ((isalnum((unsigned char)c) || c == '#') && stream->entity_len < HTML_FURI_ENTITY_SIZE)
+                {
+                    stream->entity[stream->entity_len++] = c;
+                    break;
+                }
+                // Not an entity after all, emit it as text and handle this character normally
+                html_furi_stream_end_entity(stream, false);
+            }
+            if (stream->capture == HTMLFuriStreamCaptureNone)
+            {
+                // Nothing to extract, jump straight to the next tag
+                const char *next = memchr(&text[i], '<', data_size - i);
+                if (!next)
+                {
+                    return true;
+                }
+                i = next - text;
+            }
+            else if (c == '&')
+            {
+                stream->in_entity = true;
+                stream->entity_len = 0;
+                break;
+            }
+            else if (c != '<')
+            {
+                html_furi_stream_emit_char(stream, c);
+                break;
+            }
+            stream->state = HTMLFuriStreamStateTagOpen;
+            break;
+        case HTMLFuriStreamStateTagOpen:
+            stream->tag_len = 0;
+            stream->tag_closing = false;
+            if (c == '/')
+            {
+                stream->tag_closing = true;
+                stream->state = HTMLFuriStreamStateTagName;
+            }
+            else if (isalpha((unsigned char)c))
+            {
+                stream->state = HTMLFuriStreamStateTagName;
+                continue; // read the first character as part of the name
+            }
+            else if (c == '!')
+            {
+                stream->dashes = 0;
+                stream->state = HTMLFuriStreamStateBang;
+            }
+            else if (c == '?')
+            {
+                stream->state = HTMLFuriStreamStateDeclaration;
+            }
+            else
+            {
+                // A stray '<' is text
+                if (stream->capture != HTMLFuriStreamCaptureNone)
+                {
+                    html_furi_stream_emit_char(stream, '<');
+                }
+                stream->state = HTMLFuriStreamStateText;
+                continue;
+            }
+            break;
+        case HTMLFuriStreamStateTagName:
+            if (isalnum((unsigned char)c))
+            {
+                if (stream->tag_len < HTML_FURI_STREAM_TAG_SIZE)
+                {
+                    // Store the name lowercased so <P> and <p> compare equal
+                    stream->tag[stream->tag_len++] = tolower((unsigned char)c);
+                }
+                break;
+            }
+            stream->tag[stream->tag_len] = '\0';
+            stream->quote = '\0';
+            stream->tag_last = '\0';
+            stream->link_tag = stream->link_callback && !stream->tag_closing && strcmp(stream->tag, "a") == 0;
+            if (stream->link_tag)
+            {
+                html_furi_stream_end_attribute(stream);
+            }
+            stream->state = HTMLFuriStreamStateTagRest;
+            continue; // the character after the name may already close the tag
+        case HTMLFuriStreamStateTagRest:
+            if (stream->link_tag)
+            {
+                html_furi_stream_link_char(stream, c);
+            }
+            if (stream->quote != '\0')
+            {
+                if (c == stream->quote)
+                {
+                    stream->quote = '\0';
+                }
+            }
+            else if (c == '>')
+            {
+                stream->tag_self_closing = stream->tag_last == '/';
+                stream->state = HTMLFuriStreamStateText;
+                html_furi_stream_handle_tag(stream);
+            }
+            else if ((c == '"' || c == '\'') && stream->tag_last == '=')
+            {
+                // Quotes only start an attribute value right after '='
+                stream->quote = c;
+            }
+            else if (!isspace((unsigned char)c))
+            {
+                stream->tag_last = c;
+            }
+            break;
+        case HTMLFuriStreamStateBang:
+            if (c == '-')
+            {
+                if (++stream->dashes == 2)
+                {
+                    stream->dashes = 0;
+                    stream->state = HTMLFuriStreamStateComment;
+                }
+                break;
+            }
+            stream->state = HTMLFuriStreamStateDeclaration;
+            continue; // a declaration such as <!DOCTYPE html>
+        case HTMLFuriStreamStateDeclaration:
+            if (c == '>')
+            {
+                stream->state = HTMLFuriStreamStateText;
+            }
+            break;
+        case HTMLFuriStreamStateComment:
+            if (c == '-')
+            {
+                stream->dashes++;
+            }
+            else if (c == '>' && stream->dashes >= 2)
+            {
+                stream->state = HTMLFuriStreamStateText;
+            }
+            else
+            {
+                // Jump to the next '-' that could start "-->"
+                const char *next = memchr(&text[i], '-', data_size - i);
+                if (!next)
+                {
+                    stream->dashes = 0;
+                    return true;
+                }
+                i = next - text;
+                stream->dashes = 1;
+            }
+            break;
+        case HTMLFuriStreamStateRawText:
+            if (stream->raw_match == 0)
+            {
+                // Jump to the next '<' that could start the closing tag
+                const char *next = memchr(&text[i], '<', data_size - i);
+                if (!next)
+                {
+                    return true;
+                }
+                i = next - text;
+                stream->raw_match = 1;
+            }
+            else if (stream->raw_match == 1)
+            {
+                stream->raw_match = c == '/' ? 2 : (c == '<' ? 1 : 0);
+            }
+            else if (stream->raw_text[stream->raw_match - 2] != '\0')
+            {
+                if (tolower((unsigned char)c) == stream->raw_text[stream->raw_match - 2])
+                {
+                    stream->raw_match++;
+                }
+                else
+                {
+                    stream->raw_match = c == '<' ? 1 : 0;
+                }
+            }
+            else if (isalnum((unsigned char)c))
+            {
+                // A longer name such as </scripts>, keep skipping
+                stream->raw_match = 0;
+            }
+            else
+            {
+                // Found </name, finish it as a regular closing tag
+                stream->tag_len = strlen(stream->raw_text);
+                memcpy(stream->tag, stream->raw_text, stream->tag_len + 1);
+                stream->tag_closing = true;
+                stream->quote = '\0';
+                stream->tag_last = '\0';
+                stream->link_tag = false;
+                stream->raw_text = NULL;
+                stream->raw_match = 0;
+                stream->state = HTMLFuriStreamStateTagRest;
+                continue;
+            }
+            break;
+        }
+        i++;
+    }
+    return true;
+}
+
+void html_furi_stream_set_link_callback(HTMLFuriStream *stream, HTMLFuriStreamLinkCallback callback, void *context)
+{
+    stream->link_callback = callback;
+    stream->link_context = context;
+}
+
+const char *html_furi_stream_get_text(HTMLFuriStream *stream)
+{
+    // Close an element left open by a truncated or malformed page
+    if (stream->in_entity)
+    {
+        html_furi_stream_end_entity(stream, false);
+    }
+    if (stream->capture != HTMLFuriStreamCaptureNone)
+    {
+        html_furi_stream_end_capture(stream);
+    }
+    while (stream->output_len > 0 && isspace((unsigned char)stream->output[stream->output_len - 1]))
+    {
+        stream->output_len--;
+    }
+    stream->output[stream->output_len] = '\0';
+    return stream->output;
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include <furi.h>
+#include <furi_hal.h>
+#include <html/html_furi.h>
+
+#define HTML_FURI_STREAM_TAG_SIZE 12   // Longest tag name tracked by the stream parser
+#define HTML_FURI_STREAM_HREF_SIZE 128 // Longest link target reported by the stream parser
+
+// Called with the href of each <a> tag; the string is only valid during the call
+typedef void (*HTMLFuriStreamLinkCallback)(const char *href, void *context);
+
+// Tokenizer state of the stream parser
+typedef enum
+{
+    HTMLFuriStreamStateText,        // Between tags
+    HTMLFuriStreamStateTagOpen,     // Just read '<'
+    HTMLFuriStreamStateTagName,     // Reading the tag name
+    HTMLFuriStreamStateTagRest,     // Skipping attributes until '>'
+    HTMLFuriStreamStateBang,        // Just read "<!", checking for a comment
+    HTMLFuriStreamStateDeclaration, // Skipping <!...> or <?...> until '>'
+    HTMLFuriStreamStateComment,     // Skipping <!-- ... --> until "-->"
+    HTMLFuriStreamStateRawText,     // Skipping <script>, <style> or <noscript> content until its closing tag
+} HTMLFuriStreamState;
+
+// Element whose text is currently being extracted
+typedef enum
+{
+    HTMLFuriStreamCaptureNone,
+    HTMLFuriStreamCaptureTitle,
+    HTMLFuriStreamCaptureH1,
+    HTMLFuriStreamCaptureH2,
+    HTMLFuriStreamCaptureH3,
+    HTMLFuriStreamCaptureP,
+} HTMLFuriStreamCapture;
+
+// Single-pass HTML text extractor
+typedef struct
+{
+    HTMLFuriStreamState state;
+    char tag[HTML_FURI_STREAM_TAG_SIZE + 1]; // Name of the tag being read
+    size_t tag_len;                          // Length of the tag name
+    bool tag_closing;                        // Indicates if the tag is a closing tag
+    bool tag_self_closing;                   // Indicates if the tag ends with "/>"
+    char quote;                              // Quote character while inside an attribute value
+    char tag_last;                           // Last character outside quotes in the tag's attributes
+    size_t dashes;                           // Consecutive '-' read in a comment or after "<!"
+    const char *raw_text;                    // Name of the raw text element being skipped
+    size_t raw_match;                        // Characters of "</name" matched in raw text
+
+    bool link_tag;                              // Indicates if the tag's href is reported to link_callback
+    char attribute[HTML_FURI_STREAM_TAG_SIZE + 1]; // Name of the attribute being read in a link tag
+    size_t attribute_len;                       // Length of the attribute name
+    bool attribute_done;                        // Indicates if whitespace ended the attribute name
+    bool value_unquoted;                        // Indicates if an unquoted attribute value is being read
+    bool in_href;                               // Indicates if the value being read is the href
+    char href[HTML_FURI_STREAM_HREF_SIZE + 1];  // The href read so far
+    size_t href_len;                            // Length of the href
+    bool href_overflow;                         // Indicates if the href was too long to report
+    HTMLFuriStreamLinkCallback link_callback;   // Receives the href of each <a> tag, or NULL
+    void *link_context;                         // Context passed to link_callback
+
+    char entity[HTML_FURI_ENTITY_SIZE + 1]; // Name of the entity being read, after '&'
+    size_t entity_len;                      // Length of the entity name
+    bool in_entity;                         // Indicates if an entity is being read
+
+    HTMLFuriStreamCapture capture; // Element being extracted
+    size_t capture_depth;          // Nesting depth of the extracted element
+    size_t capture_prefix_start;   // Output length before the element's prefix (e.g. "Title: ")
+    size_t capture_start;          // Output length where the element's text starts
+    bool head_found;               // Indicates if a <head> tag was seen
+
+    char *output;           // Extracted text, always NUL-terminated
+    size_t output_len;      // Length of the extracted text
+    size_t output_capacity; // Maximum length of the extracted text
+    bool truncated;         // Indicates if text was dropped because the output was full
+} HTMLFuriStream;
+
+/*
+ * @brief Allocate a stream parser that extracts title, heading and paragraph text.
+ * @param max_output The maximum number of characters of extracted text to keep.
+ * @return The stream parser, or NULL on failure.
+ */
+HTMLFuriStream *html_furi_stream_alloc(size_t max_output);
+
+/*
+ * @brief Free a stream parser.
+ * @param stream The stream parser to free.
+ */
+void html_furi_stream_free(HTMLFuriStream *stream);
+
+/*
+ * @brief Reset a stream parser so it can parse a new document.
+ * @param stream The stream parser to reset.
+ */
+void html_furi_stream_reset(HTMLFuriStream *stream);
+
+/*
+ * @brief Feed the next chunk of the document to the stream parser.
+ *
+ * Chunks can be split anywhere, including in the middle of a tag. Text inside
+ * <title>, <h1>, <h2>, <h3> and <p> is appended to the output in document order
+ * with nested tags removed. Tag names are matched regardless of case and attributes.
+ * Entities are decoded and runs of whitespace are collapsed as the text is emitted.
+ * Comments and the content of <script>, <style> and <noscript> are skipped.
+ *
+ * @param data The chunk of HTML.
+ * @param data_size The size of the chunk.
+ * @param context The HTMLFuriStream.
+ * @return Always true, so the function can be used as a FlipperHTTP parser sink.
+ */
+bool html_furi_stream_feed(const uint8_t *data, size_t data_size, void *context);
+
+/*
+ * @brief Report the href of every <a> tag while the page is parsed.
+ *
+ * The link is reported as written in the page, without resolving it or decoding entities.
+ * Links longer than HTML_FURI_STREAM_HREF_SIZE are dropped. The callback survives
+ * html_furi_stream_reset.
+ *
+ * @param stream The stream parser.
+ * @param callback The function to call with each href, or NULL to stop reporting links.
+ * @param context The context passed to the callback.
+ */
+void html_furi_stream_set_link_callback(HTMLFuriStream *stream, HTMLFuriStreamLinkCallback callback, void *context);
+
+/*
+ * @brief Get the text extracted so far.
+ * @param stream The stream parser.
+ * @return The extracted text with trailing whitespace removed.
+ */
+const char *html_furi_stream_get_text(HTMLFuriStream *stream);
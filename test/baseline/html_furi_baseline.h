@@ -0,0 +1,14 @@
+// Description: html_furi as it was before the single-pass, raw-pointer and tag-matching changes
+// File: test/baseline/html_furi_baseline.h
+#pragma once
+#include <furi.h>
+#include <furi_hal.h>
+
+// Content of the first exact "<tag>" from index up to its matching closing tag, trimmed; NULL if not found
+FuriString *html_furi_baseline_find_tag(const char *tag, FuriString *html, size_t index);
+
+// Content of every exact "<tag>", each trimmed and followed by a newline
+FuriString *html_furi_baseline_find_tags(const char *tag, FuriString *html);
+
+// Whether the exact "<tag>" occurs from index on
+bool html_furi_baseline_tag_exists(const char *tag, FuriString *html, size_t index);
@@ -0,0 +1,220 @@
+// Description: Time from the last byte of a response to the waiter waking and the loader's custom event
+// License: MIT
+// File: test/bench_completion_latency.c
+//
+// flipper_http_alloc runs on the serial shim and the bench plays the board: each trial sends a request,
+// waits a random time, then plays a short GET response. Four waiters watch the same response:
+//   poll 100 ms     the flipper_http_process_response_async loop before completion was signalled
+//   event flag      the current flipper_http_process_response_async
+//   loader 250 ms   the loader view's periodic timer, how the screen noticed the response before
+//   complete cb     the complete callback posting the loader's custom event, as the loader now does
+// Latency is measured from the moment the DMA event with the last byte fires.
+#include <flipper_http/flipper_http.c>
+#include <shim/shim.h>
+#include <stdatomic.h>
+
+#define BENCH_TRIALS 10                // Responses played
+#define BENCH_DELAY_MAX_MS 250         // Longest random wait between request and response
+#define BENCH_POLL_MS 100              // The original process_response_async poll interval
+#define BENCH_LOADER_TICK_MS 250       // The loader view's timer period
+#define BENCH_CUSTOM_EVENT_PROCESS 1   // Stands in for WebCrawlerCustomEventProcess
+
+typedef enum
+{
+    BenchWaiterPoll,
+    BenchWaiterEvent,
+    BenchWaiterLoaderTick,
+    BenchWaiterComplete,
+    BenchWaiterCount,
+} BenchWaiter;
+
+static const char *bench_waiter_names[BenchWaiterCount] = {"poll 100 ms", "event flag", "loader 250 ms", "complete cb"};
+
+typedef struct
+{
+    _Atomic uint64_t last_byte_ns;              // When the last byte of the response arrived, 0 before
+    _Atomic uint64_t woke_ns[BenchWaiterCount]; // When each waiter noticed the response, 0 before
+} BenchTrial;
+
+static BenchTrial bench_trial;
+
+static bool bench_http_request(void)
+{
+    return true; // The request line itself does not matter to the timing
+}
+
+static bool bench_parse_json(void)
+{
+    return true;
+}
+
+static void bench_woke(BenchWaiter waiter)
+{
+    uint64_t expected = 0;
+    atomic_compare_exchange_strong(&bench_trial.woke_ns[waiter], &expected, furi_shim_now_ns());
+}
+
+// flipper_http_process_response_async before completion was signalled, verbatim apart from the parser
+static bool bench_original_process_response_async(FlipperHTTP *fhttp, bool (*http_request)(void), bool (*parse_json)(void))
+{
+    if (http_request()) // start the async request
+    {
+        furi_timer_start(fhttp->get_timeout_timer, TIMEOUT_DURATION_TICKS);
+        fhttp->state = RECEIVING;
+    }
+    else
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to send request");
+        return false;
+    }
+    while (fhttp->state == RECEIVING && furi_timer_is_running(fhttp->get_timeout_timer) > 0)
+    {
+        // Wait for the request to be received
+        furi_delay_ms(BENCH_POLL_MS);
+    }
+    furi_timer_stop(fhttp->get_timeout_timer);
+    if (!parse_json()) // parse the JSON before switching to the view (synchonous)
+    {
+        FURI_LOG_E(HTTP_TAG, "Failed to parse the JSON...");
+        return false;
+    }
+    return true;
+}
+
+static int32_t bench_poll_thread(void *context)
+{
+    FlipperHTTP *fhttp = context;
+    bench_original_process_response_async(fhttp, bench_http_request, bench_parse_json);
+    bench_woke(BenchWaiterPoll);
+    return 0;
+}
+
+static int32_t bench_event_thread(void *context)
+{
+    FlipperHTTP *fhttp = context;
+    flipper_http_process_response_async(fhttp, bench_http_request, bench_parse_json);
+    bench_woke(BenchWaiterEvent);
+    return 0;
+}
+
+// The loader's timer tick noticed a finished request when it found the connection idle again
+static void bench_loader_tick(void *context)
+{
+    FlipperHTTP *fhttp = context;
+    if (atomic_load(&bench_trial.last_byte_ns) != 0 && fhttp->state == IDLE)
+    {
+        bench_woke(BenchWaiterLoaderTick);
+    }
+}
+
+// As web_crawler_loader_complete_callback: queue the loader's event from the worker
+static void bench_complete_callback(void *context)
+{
+    UNUSED(context);
+    view_dispatcher_send_custom_event(NULL, BENCH_CUSTOM_EVENT_PROCESS);
+}
+
+static void bench_custom_event(uint32_t event, void *context)
+{
+    UNUSED(context);
+    if (event == BENCH_CUSTOM_EVENT_PROCESS && atomic_load(&bench_trial.last_byte_ns) != 0)
+    {
+        bench_woke(BenchWaiterComplete);
+    }
+}
+
+static bool bench_sink_parse(const uint8_t *data, size_t data_size, void *context)
+{
+    UNUSED(data);
+    UNUSED(data_size);
+    UNUSED(context);
+    return true;
+}
+
+// Play one request and response; returns false if a waiter missed the response
+static bool bench_run_trial(FlipperHTTP *fhttp, uint32_t delay_ms)
+{
+    static const char response_head[] = "[GET/SUCCESS] GET request successful.\n{\"origin\": \"203.0.113.7\"}\n";
+    static const char response_end[] = "[GET/END]\n";
+
+    atomic_store(&bench_trial.last_byte_ns, 0);
+    for (BenchWaiter waiter = 0; waiter < BenchWaiterCount; waiter++)
+    {
+        atomic_store(&bench_trial.woke_ns[waiter], 0);
+    }
+    fhttp->save_received_data = true;
+
+    FuriThread *poll = furi_thread_alloc_ex("BenchPoll", 1024, bench_poll_thread, fhttp);
+    FuriThread *event = furi_thread_alloc_ex("BenchEvent", 1024, bench_event_thread, fhttp);
+    furi_thread_start(event);
+    furi_thread_start(poll);
+    while (fhttp->state != RECEIVING)
+    {
+        furi_delay_ms(1);
+    }
+    FuriTimer *loader_timer = furi_timer_alloc(bench_loader_tick, FuriTimerTypePeriodic, fhttp);
+    furi_timer_start(loader_timer, BENCH_LOADER_TICK_MS);
+
+    furi_delay_ms(delay_ms);
+    serial_shim_receive((const uint8_t *)response_head, sizeof(response_head) - 1);
+    atomic_store(&bench_trial.last_byte_ns, furi_shim_now_ns());
+    serial_shim_receive((const uint8_t *)response_end, sizeof(response_end) - 1);
+
+    furi_thread_join(event);
+    furi_thread_join(poll);
+    for (uint32_t waited = 0; atomic_load(&bench_trial.woke_ns[BenchWaiterLoaderTick]) == 0 && waited < 2 * BENCH_LOADER_TICK_MS; waited++)
+    {
+        furi_delay_ms(1);
+    }
+    furi_timer_stop(loader_timer);
+    furi_timer_free(loader_timer);
+    furi_thread_free(poll);
+    furi_thread_free(event);
+
+    bool all_woke = true;
+    for (BenchWaiter waiter = 0; waiter < BenchWaiterCount; waiter++)
+    {
+        all_woke = all_woke && atomic_load(&bench_trial.woke_ns[waiter]) != 0;
+    }
+    return all_woke;
+}
+
+int main(void)
+{
+    FlipperHTTP *fhttp = flipper_http_alloc();
+    furi_check(fhttp);
+    flipper_http_set_sink_parser(fhttp, bench_sink_parse, NULL);
+    flipper_http_set_complete_callback(fhttp, bench_complete_callback, NULL);
+    gui_shim_set_custom_event_hook(bench_custom_event, NULL);
+    fhttp->state = IDLE;
+
+    double total_ms[BenchWaiterCount] = {0};
+    double worst_ms[BenchWaiterCount] = {0};
+    int failures = 0;
+    srand(1);
+    for (int trial = 0; trial < BENCH_TRIALS; trial++)
+    {
+        SHIM_CHECK(failures, bench_run_trial(fhttp, (uint32_t)(rand() % BENCH_DELAY_MAX_MS)));
+        uint64_t last_byte = atomic_load(&bench_trial.last_byte_ns);
+        for (BenchWaiter waiter = 0; waiter < BenchWaiterCount; waiter++)
+        {
+            uint64_t woke = atomic_load(&bench_trial.woke_ns[waiter]);
+            double latency_ms = woke > last_byte ? (double)(woke - last_byte) / 1e6 : 0.0;
+            total_ms[waiter] += latency_ms;
+            worst_ms[waiter] = latency_ms > worst_ms[waiter] ? latency_ms : worst_ms[waiter];
+        }
+    }
+
+    printf("%-14s %12s %12s   (%d responses)\n", "waiter", "mean ms", "worst ms", BENCH_TRIALS);
+    for (BenchWaiter waiter = 0; waiter < BenchWaiterCount; waiter++)
+    {
+        printf("%-14s %12.3f %12.3f\n", bench_waiter_names[waiter], total_ms[waiter] / BENCH_TRIALS, worst_ms[waiter]);
+    }
+
+    // Signalled completion must beat both polls; on the host it takes well under a millisecond
+    SHIM_CHECK(failures, total_ms[BenchWaiterEvent] < total_ms[BenchWaiterPoll]);
+    SHIM_CHECK(failures, total_ms[BenchWaiterComplete] < total_ms[BenchWaiterLoaderTick]);
+
+    flipper_http_free(fhttp);
+    return failures ? 1 : 0;
+}
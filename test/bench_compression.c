@@ -0,0 +1,347 @@
+// Description: Compression ratio and effective transfer rate of heatshrink-compressed response bodies
+// License: MIT
+// File: test/bench_compression.c
+//
+// flipper_http_alloc runs on the serial shim and the bench plays the board: it answers [FRAME/ON] and
+// [COMPRESS/ON], then sends each corpus file as a GET/BYTES response in FlipperHTTPFrameData frames,
+// first as is and then compressed by the encoder below (greedy longest match in the 1 KB window, the
+// format HeatshrinkStream decodes). The memory sink must receive every file byte for byte both times.
+// Transfer rates count every byte on the wire, status frames and frame overhead included; the decoder
+// rate is heatshrink_stream_decode alone on the host.
+#include <flipper_http/flipper_http.c>
+#include <shim/shim.h>
+
+#define BENCH_WINDOW (1 << HEATSHRINK_STREAM_WINDOW_BITS)       // Farthest back-reference
+#define BENCH_LOOKAHEAD (1 << HEATSHRINK_STREAM_LOOKAHEAD_BITS) // Longest back-reference
+#define BENCH_DECODE_RUNS 20                                    // Decoder runs per file, the fastest is reported
+#define BENCH_TIMEOUT_MS 5000                                   // Longest wait for a response to complete
+
+typedef struct
+{
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+} BenchBuffer;
+
+typedef struct
+{
+    BenchBuffer *out;
+    uint32_t bits; // Bits not yet written out
+    uint8_t count; // Number of them
+} BenchBitWriter;
+
+static void bench_buffer_reserve(BenchBuffer *buffer, size_t size)
+{
+    if (buffer->size + size > buffer->capacity)
+    {
+        buffer->capacity = (buffer->size + size) * 2;
+        buffer->data = realloc(buffer->data, buffer->capacity);
+        furi_check(buffer->data);
+    }
+}
+
+static void bench_buffer_append(BenchBuffer *buffer, const void *data, size_t size)
+{
+    bench_buffer_reserve(buffer, size);
+    memcpy(&buffer->data[buffer->size], data, size);
+    buffer->size += size;
+}
+
+// Write the low bit_count bits of value, most significant first
+static void bench_bits(BenchBitWriter *writer, uint32_t value, uint8_t bit_count)
+{
+    writer->bits = (writer->bits << bit_count) | (value & ((1u << bit_count) - 1));
+    writer->count += bit_count;
+    while (writer->count >= 8)
+    {
+        writer->count -= 8;
+        uint8_t byte = (uint8_t)(writer->bits >> writer->count);
+        bench_buffer_append(writer->out, &byte, 1);
+    }
+}
+
+// Heatshrink encoder: a hash chain of 2-byte prefixes finds the longest match in the window,
+// which is used whenever it is shorter than the literals it replaces
+static void bench_compress(const uint8_t *data, size_t size, BenchBuffer *out)
+{
+    int32_t *head = malloc(65536 * sizeof(int32_t));      // Last position of each 2-byte prefix, -1 for none
+    int32_t *prev = malloc((size + 1) * sizeof(int32_t)); // Previous position with the same prefix
+    furi_check(head && prev);
+    memset(head, 0xFF, 65536 * sizeof(int32_t));
+
+    BenchBitWriter writer = {.out = out};
+    size_t i = 0;
+    while (i < size)
+    {
+        size_t best = 0;
+        size_t best_index = 0;
+        if (i + 1 < size)
+        {
+            for (int32_t j = head[data[i] << 8 | data[i + 1]]; j >= 0 && i - (size_t)j <= BENCH_WINDOW; j = prev[j])
+            {
+                size_t len = 0;
+                while (len < BENCH_LOOKAHEAD && i + len < size && data[j + len] == data[i + len])
+                {
+                    len++;
+                }
+                if (len > best)
+                {
+                    best = len;
+                    best_index = i - (size_t)j;
+                }
+                if (best == BENCH_LOOKAHEAD)
+                {
+                    break;
+                }
+            }
+        }
+
+        // A back-reference costs a tag bit, the index and the count; a literal costs 9 bits
+        size_t step = 1;
+        if (best >= 2 && best * 9 > 1 + HEATSHRINK_STREAM_WINDOW_BITS + HEATSHRINK_STREAM_LOOKAHEAD_BITS)
+        {
+            bench_bits(&writer, 0, 1);
+            bench_bits(&writer, (uint32_t)(best_index - 1), HEATSHRINK_STREAM_WINDOW_BITS);
+            bench_bits(&writer, (uint32_t)(best - 1), HEATSHRINK_STREAM_LOOKAHEAD_BITS);
+            step = best;
+        }
+        else
+        {
+            bench_bits(&writer, 1, 1);
+            bench_bits(&writer, data[i], 8);
+        }
+        for (size_t k = i; k < i + step && k + 1 < size; k++)
+        {
+            uint16_t prefix = (uint16_t)(data[k] << 8 | data[k + 1]);
+            prev[k] = head[prefix];
+            head[prefix] = (int32_t)k;
+        }
+        i += step;
+    }
+    if (writer.count > 0)
+    {
+        bench_bits(&writer, 0, (uint8_t)(8 - writer.count)); // Zero bits pad the last byte
+    }
+    free(prev);
+    free(head);
+}
+
+// Append one frame as the board sends it
+static void bench_frame(BenchBuffer *wire, FlipperHTTPFrameType type, const uint8_t *payload, size_t len)
+{
+    uint8_t header[1 + FRAME_HEADER_SIZE] = {FRAME_SYNC, (uint8_t)type, (uint8_t)(len & 0xFF), (uint8_t)(len >> 8)};
+    uint16_t crc = flipper_http_crc16(0xFFFF, &header[1], FRAME_HEADER_SIZE);
+    crc = flipper_http_crc16(crc, payload, len);
+    uint8_t trailer[FRAME_CRC_SIZE] = {(uint8_t)(crc & 0xFF), (uint8_t)(crc >> 8)};
+    bench_buffer_append(wire, header, sizeof(header));
+    bench_buffer_append(wire, payload, len);
+    bench_buffer_append(wire, trailer, sizeof(trailer));
+}
+
+// The whole response to a GET/BYTES request with the given body
+static void bench_response(BenchBuffer *wire, const uint8_t *body, size_t size)
+{
+    static const char head[] = "[GET/SUCCESS] GET request successful.";
+    static const char end[] = "[GET/END]";
+    wire->size = 0;
+    bench_frame(wire, FlipperHTTPFrameLine, (const uint8_t *)head, sizeof(head) - 1);
+    for (size_t offset = 0; offset < size; offset += FRAME_MAX_PAYLOAD)
+    {
+        bench_frame(wire, FlipperHTTPFrameData, body + offset, MIN((size_t)FRAME_MAX_PAYLOAD, size - offset));
+    }
+    bench_frame(wire, FlipperHTTPFrameLine, (const uint8_t *)end, sizeof(end) - 1);
+}
+
+// The board's answers to the negotiation; the answer to [FRAME/ON] is the last line before frames
+static void bench_board(const uint8_t *data, size_t data_size, void *context)
+{
+    UNUSED(context);
+    static const char frame_on[] = "[FRAME/ON]\n";
+    static const char compress_on[] = "[COMPRESS/ON]";
+    if (data_size >= 10 && memcmp(data, "[FRAME/ON]", 10) == 0)
+    {
+        serial_shim_receive((const uint8_t *)frame_on, sizeof(frame_on) - 1);
+    }
+    else if (data_size >= 13 && memcmp(data, compress_on, 13) == 0)
+    {
+        BenchBuffer answer = {0};
+        bench_frame(&answer, FlipperHTTPFrameLine, (const uint8_t *)compress_on, sizeof(compress_on) - 1);
+        serial_shim_receive(answer.data, answer.size);
+        free(answer.data);
+    }
+}
+
+// Play the response like the board, never faster than the worker drains the stream buffer
+static void bench_replay(FlipperHTTP *fhttp, const BenchBuffer *wire)
+{
+    for (size_t offset = 0; offset < wire->size; offset += RX_CHUNK_SIZE)
+    {
+        while (furi_stream_buffer_bytes_available(fhttp->flipper_http_stream) > RX_BUF_SIZE - RX_CHUNK_SIZE)
+        {
+            furi_delay_ms(1);
+        }
+        serial_shim_receive(wire->data + offset, MIN((size_t)RX_CHUNK_SIZE, wire->size - offset));
+    }
+}
+
+// Request a file and play its response; returns true if the sink received it exactly
+static bool bench_transfer(FlipperHTTP *fhttp, FlipperHTTPMemorySink *memory, const BenchBuffer *wire, FuriString *file)
+{
+    flipper_http_set_sink_memory(fhttp, memory);
+    furi_event_flag_clear(fhttp->events, FlipperHTTPEvtComplete);
+    fhttp->is_bytes_request = true;
+    if (!flipper_http_get_request_bytes(fhttp, "https://example.com/file", "{}"))
+    {
+        return false;
+    }
+    bench_replay(fhttp, wire);
+    uint32_t flags = furi_event_flag_wait(fhttp->events, FlipperHTTPEvtComplete, FuriFlagWaitAny, BENCH_TIMEOUT_MS);
+    return !(flags & FuriFlagError) && fhttp->active_request == FlipperHTTPRequestNone && !memory->truncated &&
+           memory->size == furi_string_size(file) &&
+           memcmp(memory->data, furi_string_get_cstr(file), memory->size) == 0;
+}
+
+static bool bench_count_decoded(const uint8_t *data, size_t data_size, void *context)
+{
+    UNUSED(data);
+    *(size_t *)context += data_size;
+    return true;
+}
+
+// Fastest of BENCH_DECODE_RUNS decodes of a compressed file, in nanoseconds
+static uint64_t bench_decode(const BenchBuffer *compressed, size_t size)
+{
+    static HeatshrinkStream stream;
+    uint64_t fastest = UINT64_MAX;
+    for (int run = 0; run < BENCH_DECODE_RUNS; run++)
+    {
+        size_t decoded = 0;
+        uint64_t start = furi_shim_now_ns();
+        heatshrink_stream_reset(&stream);
+        heatshrink_stream_decode(&stream, compressed->data, compressed->size, bench_count_decoded, &decoded);
+        uint64_t elapsed = furi_shim_now_ns() - start;
+        furi_check(decoded == size && heatshrink_stream_finished(&stream));
+        fastest = MIN(fastest, elapsed);
+    }
+    return fastest;
+}
+
+int main(int argc, char **argv)
+{
+    const char *corpus = argc > 1 ? argv[1] : "corpus";
+    static const char *names[] = {
+        "rustdoc-what-is-rustdoc.html",
+        "rustc-lint-groups.html",
+        "book-installation.html",
+        "std-index.html",
+        "cargo-manifest-schema.json",
+    };
+    static const uint32_t baudrates[] = {BAUDRATE, 460800};
+
+    FuriString *files[COUNT_OF(names)];
+    BenchBuffer compressed[COUNT_OF(names)] = {0};
+    for (size_t i = 0; i < COUNT_OF(names); i++)
+    {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/%s", corpus, names[i]);
+        files[i] = shim_load_file(path);
+        if (!files[i])
+        {
+            fprintf(stderr, "Cannot read %s\n", path);
+            return 1;
+        }
+        bench_compress((const uint8_t *)furi_string_get_cstr(files[i]), furi_string_size(files[i]), &compressed[i]);
+    }
+
+    FlipperHTTP *fhttp = flipper_http_alloc();
+    furi_check(fhttp);
+    fhttp->state = IDLE;
+    serial_shim_set_tx_hook(bench_board, NULL);
+
+    // Every file in plain frames, then every file compressed
+    int failures = 0;
+    size_t wire_size[2][COUNT_OF(names)];
+    BenchBuffer wire = {0};
+    SHIM_CHECK(failures, flipper_http_framing(fhttp, true));
+    for (int pass = 0; pass < 2; pass++)
+    {
+        if (pass == 1)
+        {
+            SHIM_CHECK(failures, flipper_http_compression(fhttp, true));
+        }
+        for (size_t i = 0; i < COUNT_OF(names); i++)
+        {
+            size_t size = furi_string_size(files[i]);
+            FlipperHTTPMemorySink *memory = flipper_http_memory_sink_alloc(size);
+            furi_check(memory);
+            if (pass == 0)
+            {
+                bench_response(&wire, (const uint8_t *)furi_string_get_cstr(files[i]), size);
+            }
+            else
+            {
+                bench_response(&wire, compressed[i].data, compressed[i].size);
+            }
+            wire_size[pass][i] = wire.size;
+            SHIM_CHECK(failures, bench_transfer(fhttp, memory, &wire, files[i]));
+            flipper_http_memory_sink_free(memory);
+        }
+    }
+    serial_shim_set_tx_hook(NULL, NULL);
+    flipper_http_free(fhttp);
+
+    size_t total_size = 0;
+    size_t total_compressed = 0;
+    size_t total_wire[2] = {0};
+    uint64_t total_decode_ns = 0;
+    printf("%-30s %8s %10s %6s %10s %10s %11s\n", "file", "bytes", "compressed", "ratio", "plain wire", "hs wire", "decode MB/s");
+    for (size_t i = 0; i < COUNT_OF(names); i++)
+    {
+        size_t size = furi_string_size(files[i]);
+        uint64_t decode_ns = bench_decode(&compressed[i], size);
+        printf("%-30s %8zu %10zu %6.2f %10zu %10zu %11.1f\n",
+               names[i],
+               size,
+               compressed[i].size,
+               (double)size / (double)compressed[i].size,
+               wire_size[0][i],
+               wire_size[1][i],
+               (double)size * 1000.0 / (double)decode_ns);
+        total_size += size;
+        total_compressed += compressed[i].size;
+        total_wire[0] += wire_size[0][i];
+        total_wire[1] += wire_size[1][i];
+        total_decode_ns += decode_ns;
+    }
+    printf("%-30s %8zu %10zu %6.2f %10zu %10zu %11.1f\n",
+           "total",
+           total_size,
+           total_compressed,
+           (double)total_size / (double)total_compressed,
+           total_wire[0],
+           total_wire[1],
+           (double)total_size * 1000.0 / (double)total_decode_ns);
+
+    // 8N1 moves baud / 10 bytes per second; the effective rate is file bytes delivered per second
+    printf("\n%-8s %10s %12s %17s\n", "baud", "raw KB/s", "plain KB/s", "compressed KB/s");
+    for (size_t b = 0; b < COUNT_OF(baudrates); b++)
+    {
+        double raw = baudrates[b] / 10.0;
+        printf("%-8lu %10.2f %12.2f %17.2f\n",
+               (unsigned long)baudrates[b],
+               raw / 1000.0,
+               raw * (double)total_size / (double)total_wire[0] / 1000.0,
+               raw * (double)total_size / (double)total_wire[1] / 1000.0);
+    }
+
+    // Compression must pay for itself on the corpus as a whole
+    SHIM_CHECK(failures, total_wire[1] < total_wire[0]);
+
+    free(wire.data);
+    for (size_t i = 0; i < COUNT_OF(names); i++)
+    {
+        free(compressed[i].data);
+        furi_string_free(files[i]);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,139 @@
+// Description: Lookups per second, memory per million URLs and false positive rate of the crawl's visited set
+// License: MIT
+// File: test/bench_crawl_bloom.c
+//
+// For each false positive rate a filter sized for 1M URLs is filled with 1M distinct URLs, then asked
+// for those URLs (which must all be found) and for 1M URLs never added (the found ones are false
+// positives). The keys are formatted before timing starts. The filled filter is saved with
+// crawl_bloom_save, loaded into a fresh one and checked to answer the same.
+#include <crawl/crawl_bloom.h>
+#include <crawl/crawl_engine.h>
+#include <shim/shim.h>
+#include <unistd.h>
+
+#define BENCH_URLS 1000000 // URLs added, and URLs looked up that were never added
+#define BENCH_URL_SIZE 64  // Longest formatted URL
+
+typedef struct
+{
+    char *text;       // Every key, back to back
+    size_t *offsets;  // Start of each key in text
+    uint8_t *lengths; // Length of each key
+    size_t count;
+} BenchKeys;
+
+static void bench_keys_alloc(BenchKeys *keys, const char *format, size_t count)
+{
+    keys->text = malloc(count * BENCH_URL_SIZE);
+    keys->offsets = malloc(count * sizeof(size_t));
+    keys->lengths = malloc(count);
+    furi_check(keys->text && keys->offsets && keys->lengths);
+    keys->count = count;
+    size_t offset = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        int length = snprintf(keys->text + offset, BENCH_URL_SIZE, format, i, i * 7);
+        keys->offsets[i] = offset;
+        keys->lengths[i] = (uint8_t)length;
+        offset += (size_t)length;
+    }
+}
+
+static void bench_keys_free(BenchKeys *keys)
+{
+    free(keys->lengths);
+    free(keys->offsets);
+    free(keys->text);
+}
+
+// Look every key up; returns how many were reported present and the time taken
+static size_t bench_lookup(const CrawlBloom *bloom, const BenchKeys *keys, uint64_t *elapsed_ns)
+{
+    size_t found = 0;
+    uint64_t start = furi_shim_now_ns();
+    for (size_t i = 0; i < keys->count; i++)
+    {
+        found += crawl_bloom_contains(bloom, keys->text + keys->offsets[i], keys->lengths[i]);
+    }
+    *elapsed_ns = furi_shim_now_ns() - start;
+    return found;
+}
+
+// Save the filter, load it into a fresh filter of the same size and compare the bit arrays
+static bool bench_round_trip(const CrawlBloom *bloom, const char *path, float false_positive_rate)
+{
+    File *file = storage_file_alloc(NULL);
+    bool saved = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS) && crawl_bloom_save(bloom, file);
+    storage_file_close(file);
+
+    CrawlBloom *loaded = crawl_bloom_alloc(BENCH_URLS, false_positive_rate);
+    furi_check(loaded);
+    bool restored = saved &&
+                    storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+                    crawl_bloom_load(loaded, file) &&
+                    loaded->count == bloom->count &&
+                    memcmp(loaded->data, bloom->data, bloom->bits / 8) == 0;
+    storage_file_free(file);
+    crawl_bloom_free(loaded);
+    unlink(path);
+    return restored;
+}
+
+int main(void)
+{
+    static const float rates[] = {0.01f, 0.001f};
+    BenchKeys added;
+    BenchKeys absent;
+    bench_keys_alloc(&added, "https://example.com/page/%zu?x=%zu", BENCH_URLS);
+    bench_keys_alloc(&absent, "https://other.org/item/%zu/%zu", BENCH_URLS);
+
+    char path[] = "/tmp/bench_crawl_bloom_XXXXXX";
+    int fd = mkstemp(path);
+    furi_check(fd >= 0);
+    close(fd);
+
+    int failures = 0;
+    printf("%-6s %4s %10s %14s %10s %12s %12s\n", "rate", "k", "bits/URL", "MiB/1M URLs", "measured", "hit Mlook/s", "miss Mlook/s");
+    for (size_t r = 0; r < COUNT_OF(rates); r++)
+    {
+        CrawlBloom *bloom = crawl_bloom_alloc(BENCH_URLS, rates[r]);
+        furi_check(bloom);
+        for (size_t i = 0; i < added.count; i++)
+        {
+            crawl_bloom_add(bloom, added.text + added.offsets[i], added.lengths[i]);
+        }
+
+        uint64_t hit_ns;
+        uint64_t miss_ns;
+        size_t hits = bench_lookup(bloom, &added, &hit_ns);
+        size_t false_positives = bench_lookup(bloom, &absent, &miss_ns);
+        double measured = (double)false_positives / (double)absent.count;
+        printf("%-6.3f %4lu %10.2f %14.2f %9.3f%% %12.2f %12.2f\n",
+               (double)rates[r],
+               (unsigned long)bloom->hashes,
+               (double)bloom->bits / BENCH_URLS,
+               (double)bloom->bits / 8.0 / (1024.0 * 1024.0) * (1000000.0 / BENCH_URLS),
+               measured * 100.0,
+               (double)added.count * 1000.0 / (double)hit_ns,
+               (double)absent.count * 1000.0 / (double)miss_ns);
+
+        // A Bloom filter never misses an added key, and stays near the rate it was sized for
+        SHIM_CHECK(failures, hits == added.count);
+        SHIM_CHECK(failures, measured < rates[r] * 1.5);
+        SHIM_CHECK(failures, bench_round_trip(bloom, path, rates[r]));
+        crawl_bloom_free(bloom);
+    }
+
+    CrawlBloom *device = crawl_bloom_alloc(CRAWL_ENGINE_VISITED_CAPACITY, CRAWL_ENGINE_VISITED_FALSE_POSITIVE_RATE);
+    furi_check(device);
+    printf("device default: %d URLs at %.3f, %lu bytes, k = %lu\n",
+           CRAWL_ENGINE_VISITED_CAPACITY,
+           (double)CRAWL_ENGINE_VISITED_FALSE_POSITIVE_RATE,
+           (unsigned long)(device->bits / 8),
+           (unsigned long)device->hashes);
+    crawl_bloom_free(device);
+
+    bench_keys_free(&absent);
+    bench_keys_free(&added);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,193 @@
+// Description: Scan count and time of the BROWSE per-tag calls against one html_furi_extract pass
+// License: MIT
+// File: test/bench_html_extract.c
+//
+// The per-tag sequence is what web_crawler_parse did before html_furi_extract: html_furi_tag_exists for
+// <head>, then html_furi_tag_exists and html_furi_find_tag for <title>, <h1>, <h2> and <h3>, then
+// html_furi_find_tags for <p>. It is timed with the original html_furi (whose furi_string_get_char calls
+// give its scan count) and with the current one; html_furi_extract finds the same tags in one traversal.
+#include <html/html_furi.h>
+#include <baseline/html_furi_baseline.h>
+#include <shim/shim.h>
+
+#define BENCH_RUNS 20 // Runs per page and method, the fastest is reported
+
+static const char *bench_tags[] = {"<head>", "<title>", "<h1>", "<h2>", "<h3>", "<p>"};
+#define BENCH_TAG_P (COUNT_OF(bench_tags) - 1)
+
+typedef FuriString *(*BenchFindTag)(const char *tag, FuriString *html, size_t index);
+typedef FuriString *(*BenchFindTags)(const char *tag, FuriString *html);
+typedef bool (*BenchTagExists)(const char *tag, FuriString *html, size_t index);
+
+typedef struct
+{
+    BenchFindTag find_tag;
+    BenchFindTags find_tags;
+    BenchTagExists tag_exists;
+} BenchHtmlApi;
+
+// The per-tag BROWSE sequence; returns the number of calls, each of which scans from its start index
+static size_t bench_per_tag(const BenchHtmlApi *api, FuriString *html, FuriString *out)
+{
+    size_t calls = 1;
+    furi_string_reset(out);
+    if (!api->tag_exists(bench_tags[0], html, 0))
+    {
+        return calls;
+    }
+    for (size_t t = 1; t < COUNT_OF(bench_tags); t++)
+    {
+        calls++;
+        if (!api->tag_exists(bench_tags[t], html, 0))
+        {
+            continue;
+        }
+        calls++;
+        FuriString *content = t == BENCH_TAG_P ? api->find_tags(bench_tags[t], html) : api->find_tag(bench_tags[t], html, 0);
+        if (content)
+        {
+            furi_string_trim(content);
+            furi_string_cat(out, content);
+            furi_string_cat_str(out, "\n");
+            furi_string_free(content);
+        }
+    }
+    return calls;
+}
+
+// The same text from one html_furi_extract pass
+static size_t bench_extract(FuriString *html, FuriString *out, HTMLFuriMatch *matches, size_t max_matches)
+{
+    furi_string_reset(out);
+    size_t match_count = html_furi_extract(bench_tags, COUNT_OF(bench_tags), html, matches, max_matches);
+    bool head = false;
+    for (size_t m = 0; m < match_count && !head; m++)
+    {
+        head = matches[m].tag_index == 0;
+    }
+    if (!head)
+    {
+        return match_count;
+    }
+    FuriString *content = furi_string_alloc();
+    FuriString *paragraphs = furi_string_alloc();
+    for (size_t t = 1; t < COUNT_OF(bench_tags); t++)
+    {
+        furi_string_reset(paragraphs);
+        for (size_t m = 0; m < match_count; m++)
+        {
+            if (matches[m].tag_index != t)
+            {
+                continue;
+            }
+            furi_string_set_n(content, html, matches[m].start, matches[m].length);
+            furi_string_trim(content);
+            furi_string_cat(paragraphs, content);
+            furi_string_cat_str(paragraphs, "\n");
+            if (t != BENCH_TAG_P)
+            {
+                break;
+            }
+        }
+        if (furi_string_size(paragraphs) > 0)
+        {
+            furi_string_trim(paragraphs);
+            furi_string_cat(out, paragraphs);
+            furi_string_cat_str(out, "\n");
+        }
+    }
+    furi_string_free(paragraphs);
+    furi_string_free(content);
+    return match_count;
+}
+
+static double bench_best_us(uint64_t best_ns)
+{
+    return (double)best_ns / 1000.0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *corpus = argc > 1 ? argv[1] : "corpus";
+    static const char *pages[] = {
+        "rustdoc-what-is-rustdoc.html",
+        "rustc-lint-groups.html",
+        "book-installation.html",
+        "std-index.html",
+    };
+    static const BenchHtmlApi baseline = {
+        html_furi_baseline_find_tag,
+        html_furi_baseline_find_tags,
+        html_furi_baseline_tag_exists,
+    };
+    static const BenchHtmlApi current = {
+        html_furi_find_tag,
+        html_furi_find_tags,
+        html_furi_tag_exists,
+    };
+
+    size_t max_matches = 512;
+    HTMLFuriMatch *matches = malloc(max_matches * sizeof(HTMLFuriMatch));
+    FuriString *per_tag_text = furi_string_alloc();
+    FuriString *extract_text = furi_string_alloc();
+    int failures = 0;
+
+    printf("%-30s %7s  %-22s %6s %7s %10s\n", "page", "bytes", "method", "calls", "scans", "us");
+    for (size_t i = 0; i < COUNT_OF(pages); i++)
+    {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/%s", corpus, pages[i]);
+        FuriString *html = shim_load_file(path);
+        if (!html)
+        {
+            fprintf(stderr, "Cannot read %s\n", path);
+            return 1;
+        }
+        size_t size = furi_string_size(html);
+
+        // Original html_furi: every byte it looks at is a furi_string_get_char call
+        uint64_t best = UINT64_MAX;
+        size_t calls = 0;
+        size_t reads = 0;
+        for (int run = 0; run < BENCH_RUNS; run++)
+        {
+            size_t reads_before = furi_shim_string_get_char_calls;
+            uint64_t start = furi_shim_now_ns();
+            calls = bench_per_tag(&baseline, html, per_tag_text);
+            uint64_t elapsed = furi_shim_now_ns() - start;
+            reads = furi_shim_string_get_char_calls - reads_before;
+            best = elapsed < best ? elapsed : best;
+        }
+        printf("%-30s %7zu  %-22s %6zu %7.1f %10.1f\n", pages[i], size, "per-tag, original", calls, (double)reads / (double)size, bench_best_us(best));
+
+        best = UINT64_MAX;
+        for (int run = 0; run < BENCH_RUNS; run++)
+        {
+            uint64_t start = furi_shim_now_ns();
+            calls = bench_per_tag(&current, html, per_tag_text);
+            uint64_t elapsed = furi_shim_now_ns() - start;
+            best = elapsed < best ? elapsed : best;
+        }
+        printf("%-30s %7s  %-22s %6zu %7s %10.1f\n", "", "", "per-tag, current", calls, "-", bench_best_us(best));
+
+        best = UINT64_MAX;
+        size_t match_count = 0;
+        for (int run = 0; run < BENCH_RUNS; run++)
+        {
+            uint64_t start = furi_shim_now_ns();
+            match_count = bench_extract(html, extract_text, matches, max_matches);
+            uint64_t elapsed = furi_shim_now_ns() - start;
+            best = elapsed < best ? elapsed : best;
+        }
+        printf("%-30s %7s  %-22s %6d %7d %10.1f  (%zu matches)\n", "", "", "html_furi_extract", 1, 1, bench_best_us(best), match_count);
+
+        // One pass must find what the current per-tag calls find
+        SHIM_CHECK(failures, furi_string_cmp(per_tag_text, extract_text) == 0);
+        furi_string_free(html);
+    }
+
+    furi_string_free(extract_text);
+    furi_string_free(per_tag_text);
+    free(matches);
+    return failures ? 1 : 0;
+}
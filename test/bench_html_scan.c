@@ -0,0 +1,115 @@
+// Description: Before/after of html_furi tag search, per-character furi_string_get_char against raw pointers
+// License: MIT
+// File: test/bench_html_scan.c
+//
+// Each page is searched with the original html_furi (test/baseline/) and the current one for:
+//   title   html_furi_find_tag("<title>"), a tag near the start
+//   p       html_furi_find_tags("<p>"), every paragraph, the hottest call in BROWSE mode
+//   miss    html_furi_find_tag("<article>"), a tag the page lacks, so the whole page is scanned
+#include <html/html_furi.h>
+#include <baseline/html_furi_baseline.h>
+#include <shim/shim.h>
+
+#define BENCH_RUNS 20 // Runs per page, search and implementation, the fastest is reported
+
+typedef enum
+{
+    BenchSearchTitle,
+    BenchSearchParagraphs,
+    BenchSearchMiss,
+    BenchSearchCount,
+} BenchSearch;
+
+static const char *bench_search_names[BenchSearchCount] = {"title", "p", "miss"};
+
+static FuriString *bench_search(bool baseline, BenchSearch search, FuriString *html)
+{
+    switch (search)
+    {
+    case BenchSearchTitle:
+        return baseline ? html_furi_baseline_find_tag("<title>", html, 0) : html_furi_find_tag("<title>", html, 0);
+    case BenchSearchParagraphs:
+        return baseline ? html_furi_baseline_find_tags("<p>", html) : html_furi_find_tags("<p>", html);
+    case BenchSearchMiss:
+    default:
+        return baseline ? html_furi_baseline_find_tag("<article>", html, 0) : html_furi_find_tag("<article>", html, 0);
+    }
+}
+
+static uint64_t bench_time(bool baseline, BenchSearch search, FuriString *html, FuriString **result)
+{
+    uint64_t best = UINT64_MAX;
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        uint64_t start = furi_shim_now_ns();
+        FuriString *found = bench_search(baseline, search, html);
+        uint64_t elapsed = furi_shim_now_ns() - start;
+        best = elapsed < best ? elapsed : best;
+        if (run == 0)
+        {
+            *result = found;
+        }
+        else if (found)
+        {
+            furi_string_free(found);
+        }
+    }
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    const char *corpus = argc > 1 ? argv[1] : "corpus";
+    static const char *pages[] = {
+        "rustdoc-what-is-rustdoc.html",
+        "rustc-lint-groups.html",
+        "book-installation.html",
+        "std-index.html",
+    };
+    int failures = 0;
+
+    printf("%-30s %7s %-6s %12s %12s %9s\n", "page", "bytes", "search", "before us", "after us", "speedup");
+    for (size_t i = 0; i < COUNT_OF(pages); i++)
+    {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/%s", corpus, pages[i]);
+        FuriString *html = shim_load_file(path);
+        if (!html)
+        {
+            fprintf(stderr, "Cannot read %s\n", path);
+            return 1;
+        }
+
+        for (BenchSearch search = 0; search < BenchSearchCount; search++)
+        {
+            FuriString *before_result = NULL;
+            FuriString *after_result = NULL;
+            uint64_t before = bench_time(true, search, html, &before_result);
+            uint64_t after = bench_time(false, search, html, &after_result);
+            printf("%-30s %7zu %-6s %12.1f %12.1f %8.1fx\n",
+                   search == 0 ? pages[i] : "",
+                   furi_string_size(html),
+                   bench_search_names[search],
+                   (double)before / 1000.0,
+                   (double)after / 1000.0,
+                   (double)before / (double)after);
+
+            // The corpus pages only use bare <title> and <p>, so both implementations must find the same text
+            SHIM_CHECK(failures, (before_result == NULL) == (after_result == NULL));
+            if (before_result && after_result)
+            {
+                SHIM_CHECK(failures, furi_string_cmp(before_result, after_result) == 0);
+            }
+            if (before_result)
+            {
+                furi_string_free(before_result);
+            }
+            if (after_result)
+            {
+                furi_string_free(after_result);
+            }
+        }
+        furi_string_free(html);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,181 @@
+// Description: Bytes per cycle of the worker's line framer on short status lines and long HTML lines
+// License: MIT
+// File: test/bench_line_framer.c
+//
+// Compares flipper_http_process_chunk (memchr, whole lines passed in place) with the per-byte framing
+// the worker did before it. Both are fed RX_CHUNK_SIZE chunks copied into rx_chunk, as the worker drains them.
+#include <flipper_http/flipper_http.c>
+#include <shim/shim.h>
+
+#define BENCH_WORKLOAD_SIZE (1024 * 1024) // Bytes framed per run
+#define BENCH_RUNS 15                     // Runs per framer and workload, the fastest is reported
+
+typedef void (*BenchFramer)(FlipperHTTP *fhttp, uint8_t *chunk, size_t len, size_t *rx_line_pos);
+
+typedef struct
+{
+    size_t lines;
+    size_t bytes;
+} BenchLines;
+
+// The worker's framing before memchr: every byte is tested and copied into rx_line_buffer
+// (unlike the original, the byte that finds the buffer full is kept, so both framers hand over the same lines)
+static void bench_per_byte_process_chunk(FlipperHTTP *fhttp, uint8_t *chunk, size_t len, size_t *rx_line_pos)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        char c = (char)chunk[i];
+        if (*rx_line_pos >= RX_LINE_BUFFER_SIZE - 1)
+        {
+            fhttp->rx_line_buffer[*rx_line_pos] = '\0';
+            fhttp->handle_rx_line_cb(fhttp->rx_line_buffer, fhttp->callback_context);
+            *rx_line_pos = 0;
+        }
+        if (c == '\n')
+        {
+            fhttp->rx_line_buffer[*rx_line_pos] = '\0';
+            fhttp->handle_rx_line_cb(fhttp->rx_line_buffer, fhttp->callback_context);
+            *rx_line_pos = 0;
+        }
+        else
+        {
+            fhttp->rx_line_buffer[(*rx_line_pos)++] = c;
+        }
+    }
+}
+
+static void bench_count_line(const char *line, void *context)
+{
+    BenchLines *lines = context;
+    lines->lines++;
+    lines->bytes += (uint8_t)line[0];
+}
+
+static void bench_measure_line(const char *line, void *context)
+{
+    BenchLines *lines = context;
+    lines->lines++;
+    lines->bytes += strlen(line);
+}
+
+static void bench_run(FlipperHTTP *fhttp, BenchFramer framer, const uint8_t *data, size_t size)
+{
+    size_t rx_line_pos = 0;
+    for (size_t offset = 0; offset < size; offset += RX_CHUNK_SIZE)
+    {
+        size_t len = size - offset < RX_CHUNK_SIZE ? size - offset : RX_CHUNK_SIZE;
+        memcpy(fhttp->rx_chunk, data + offset, len);
+        framer(fhttp, fhttp->rx_chunk, len, &rx_line_pos);
+    }
+}
+
+// Repeat source lines until the workload is BENCH_WORKLOAD_SIZE bytes, ending on a line break
+static uint8_t *bench_workload(const char *source, size_t source_size, size_t *size)
+{
+    uint8_t *data = malloc(BENCH_WORKLOAD_SIZE + source_size);
+    furi_check(data);
+    *size = 0;
+    while (*size < BENCH_WORKLOAD_SIZE)
+    {
+        memcpy(data + *size, source, source_size);
+        *size += source_size;
+    }
+    return data;
+}
+
+static int bench_workload_report(FlipperHTTP *fhttp, const char *name, const uint8_t *data, size_t size)
+{
+    static const struct
+    {
+        const char *name;
+        BenchFramer framer;
+    } framers[] = {
+        {"per-byte", bench_per_byte_process_chunk},
+        {"memchr", flipper_http_process_chunk},
+    };
+
+    // Both framers must hand over the same lines
+    BenchLines expected = {0};
+    int failures = 0;
+    for (size_t i = 0; i < COUNT_OF(framers); i++)
+    {
+        BenchLines lines = {0};
+        fhttp->handle_rx_line_cb = bench_measure_line;
+        fhttp->callback_context = &lines;
+        bench_run(fhttp, framers[i].framer, data, size);
+        if (i == 0)
+        {
+            expected = lines;
+        }
+        SHIM_CHECK(failures, lines.lines == expected.lines && lines.bytes == expected.bytes);
+    }
+
+    for (size_t i = 0; i < COUNT_OF(framers); i++)
+    {
+        BenchLines lines = {0};
+        fhttp->handle_rx_line_cb = bench_count_line;
+        fhttp->callback_context = &lines;
+        uint64_t best_cycles = UINT64_MAX;
+        uint64_t best_ns = UINT64_MAX;
+        for (int run = 0; run < BENCH_RUNS; run++)
+        {
+            uint64_t start_ns = furi_shim_now_ns();
+            uint64_t start_cycles = furi_shim_cycles();
+            bench_run(fhttp, framers[i].framer, data, size);
+            uint64_t cycles = furi_shim_cycles() - start_cycles;
+            uint64_t ns = furi_shim_now_ns() - start_ns;
+            best_cycles = cycles < best_cycles ? cycles : best_cycles;
+            best_ns = ns < best_ns ? ns : best_ns;
+        }
+        printf("%-14s %8zu %10.1f  %-9s %12.3f %10.1f\n",
+               name,
+               expected.lines,
+               (double)size / (double)expected.lines,
+               framers[i].name,
+               (double)size / (double)best_cycles,
+               (double)size * 1000.0 / (double)best_ns);
+    }
+    return failures;
+}
+
+int main(int argc, char **argv)
+{
+    const char *corpus = argc > 1 ? argv[1] : "corpus";
+
+    FlipperHTTP *fhttp = calloc(1, sizeof(FlipperHTTP));
+    furi_check(fhttp);
+
+    // Status lines as the board sends them around a request
+    static const char status[] =
+        "[PONG]\n"
+        "[SUCCESS] Command executed.\n"
+        "[GET/SUCCESS] GET request successful.\n"
+        "[INFO] Flow control enabled.\n"
+        "[GET/END]\n"
+        "[CONNECTED]\n"
+        "[ERROR] Unknown command.\n";
+    size_t status_size;
+    uint8_t *status_data = bench_workload(status, sizeof(status) - 1, &status_size);
+
+    // Lines of a saved rustdoc page, many of them several hundred bytes long
+    char path[256];
+    snprintf(path, sizeof(path), "%s/std-index.html", corpus);
+    FuriString *page = shim_load_file(path);
+    if (!page)
+    {
+        fprintf(stderr, "Cannot read %s\n", path);
+        return 1;
+    }
+    size_t html_size;
+    uint8_t *html_data = bench_workload(furi_string_get_cstr(page), furi_string_size(page), &html_size);
+
+    printf("%-14s %8s %10s  %-9s %12s %10s\n", "workload", "lines", "avg line", "framer", "bytes/cycle", "MB/s");
+    int failures = bench_workload_report(fhttp, "status lines", status_data, status_size);
+    failures += bench_workload_report(fhttp, "HTML lines", html_data, html_size);
+
+    furi_string_free(page);
+    free(html_data);
+    free(status_data);
+    free(fhttp);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,19 @@
+// Description: Host stand-in for datetime/datetime.h
+// License: MIT
+// File: test/furi/datetime/datetime.h
+#pragma once
+#include <furi.h>
+
+typedef struct
+{
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+    uint8_t day;
+    uint8_t month;
+    uint16_t year;
+    uint8_t weekday;
+} DateTime;
+
+uint32_t datetime_datetime_to_timestamp(DateTime *datetime);
+void datetime_timestamp_to_datetime(uint32_t timestamp, DateTime *datetime);
@@ -0,0 +1,197 @@
+// Description: Host stand-in for the parts of the Furi SDK the app's portable modules use
+// License: MIT
+// File: test/furi/furi.h
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <ctype.h> // The SDK's furi.h reaches ctype.h through m-string
+
+#define UNUSED(x) (void)(x)
+#define COUNT_OF(x) (sizeof(x) / sizeof(x[0]))
+#ifndef MIN
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#endif
+#ifndef CLAMP
+#define CLAMP(x, upper, lower) (MIN(upper, MAX(x, lower)))
+#endif
+
+// Logging goes to stderr so benchmark output on stdout stays clean; FURI_LOG_D and FURI_LOG_I are dropped
+void furi_shim_log(const char *level, const char *tag, const char *format, ...);
+#define FURI_LOG_E(tag, ...) furi_shim_log("E", tag, __VA_ARGS__)
+#define FURI_LOG_W(tag, ...) furi_shim_log("W", tag, __VA_ARGS__)
+#define FURI_LOG_I(tag, ...) ((void)(tag))
+#define FURI_LOG_D(tag, ...) ((void)(tag))
+
+void furi_shim_crash(const char *file, int line, const char *expression);
+#define furi_check(x, ...) ((x) ? (void)0 : furi_shim_crash(__FILE__, __LINE__, #x))
+#define furi_assert(x, ...) furi_check(x)
+#define furi_crash(...) furi_shim_crash(__FILE__, __LINE__, "furi_crash")
+
+// The RX "interrupt" runs on a host thread, so critical sections take a global lock
+void furi_shim_critical_enter(void);
+void furi_shim_critical_exit(void);
+#define FURI_CRITICAL_ENTER() furi_shim_critical_enter()
+#define FURI_CRITICAL_EXIT() furi_shim_critical_exit()
+
+#define FuriWaitForever 0xFFFFFFFFU
+
+typedef enum
+{
+    FuriStatusOk = 0,
+    FuriStatusError = -1,
+    FuriStatusErrorTimeout = -2,
+    FuriStatusErrorResource = -3,
+} FuriStatus;
+
+typedef enum
+{
+    FuriFlagWaitAny = 0x00000000U,
+    FuriFlagWaitAll = 0x00000001U,
+    FuriFlagNoClear = 0x00000002U,
+    FuriFlagError = 0x80000000U,
+    FuriFlagErrorTimeout = 0xFFFFFFFEU,
+} FuriFlag;
+
+// Kernel
+uint32_t furi_get_tick(void);
+uint32_t furi_kernel_get_tick_frequency(void);
+uint32_t furi_ms_to_ticks(uint32_t milliseconds);
+void furi_delay_ms(uint32_t milliseconds);
+size_t memmgr_get_free_heap(void);
+
+// Records
+#define RECORD_STORAGE "storage"
+#define RECORD_GUI "gui"
+void *furi_record_open(const char *name);
+void furi_record_close(const char *name);
+
+// Strings
+typedef struct FuriString FuriString;
+#define FURI_STRING_FAILURE ((size_t) - 1)
+FuriString *furi_string_alloc(void);
+FuriString *furi_string_alloc_set(const FuriString *source);
+FuriString *furi_string_alloc_set_str(const char *cstr);
+void furi_string_free(FuriString *string);
+void furi_string_reset(FuriString *string);
+void furi_string_reserve(FuriString *string, size_t size);
+size_t furi_string_size(const FuriString *string);
+const char *furi_string_get_cstr(const FuriString *string);
+char furi_string_get_char(const FuriString *string, size_t index);
+void furi_string_set(FuriString *string, FuriString *source);
+void furi_string_set_str(FuriString *string, const char *cstr);
+void furi_string_set_strn(FuriString *string, const char *cstr, size_t n);
+void furi_string_set_n(FuriString *string, const FuriString *source, size_t offset, size_t length);
+void furi_string_cat(FuriString *string, const FuriString *source);
+void furi_string_cat_str(FuriString *string, const char *cstr);
+int furi_string_cat_printf(FuriString *string, const char *format, ...);
+int furi_string_printf(FuriString *string, const char *format, ...);
+void furi_string_push_back(FuriString *string, char c);
+void furi_string_left(FuriString *string, size_t index);
+void furi_string_right(FuriString *string, size_t index);
+void furi_string_mid(FuriString *string, size_t index, size_t size);
+void furi_string_trim(FuriString *string);
+int furi_string_cmp(const FuriString *string_1, const FuriString *string_2);
+int furi_string_cmp_str(const FuriString *string, const char *cstr);
+bool furi_string_equal_str(const FuriString *string, const char *cstr);
+size_t furi_string_search_str(const FuriString *string, const char *needle, size_t start);
+size_t furi_string_search_char(const FuriString *string, char c, size_t start);
+
+// Threads and thread flags
+typedef struct FuriThread FuriThread;
+typedef void *FuriThreadId;
+typedef int32_t (*FuriThreadCallback)(void *context);
+typedef enum
+{
+    FuriThreadPriorityNone = 0,
+    FuriThreadPriorityIdle = 1,
+    FuriThreadPriorityLowest = 14,
+    FuriThreadPriorityLow = 15,
+    FuriThreadPriorityNormal = 16,
+    FuriThreadPriorityHigh = 17,
+    FuriThreadPriorityHighest = 18,
+} FuriThreadPriority;
+FuriThread *furi_thread_alloc(void);
+FuriThread *furi_thread_alloc_ex(const char *name, uint32_t stack_size, FuriThreadCallback callback, void *context);
+void furi_thread_free(FuriThread *thread);
+void furi_thread_set_name(FuriThread *thread, const char *name);
+void furi_thread_set_stack_size(FuriThread *thread, size_t stack_size);
+void furi_thread_set_context(FuriThread *thread, void *context);
+void furi_thread_set_callback(FuriThread *thread, FuriThreadCallback callback);
+void furi_thread_set_priority(FuriThread *thread, FuriThreadPriority priority);
+void furi_thread_start(FuriThread *thread);
+bool furi_thread_join(FuriThread *thread);
+FuriThreadId furi_thread_get_id(FuriThread *thread);
+FuriThreadId furi_thread_get_current_id(void);
+uint32_t furi_thread_flags_set(FuriThreadId thread_id, uint32_t flags);
+uint32_t furi_thread_flags_clear(uint32_t flags);
+uint32_t furi_thread_flags_get(void);
+uint32_t furi_thread_flags_wait(uint32_t flags, uint32_t options, uint32_t timeout);
+
+// Mutex
+typedef struct FuriMutex FuriMutex;
+typedef enum
+{
+    FuriMutexTypeNormal,
+    FuriMutexTypeRecursive,
+} FuriMutexType;
+FuriMutex *furi_mutex_alloc(FuriMutexType type);
+void furi_mutex_free(FuriMutex *mutex);
+FuriStatus furi_mutex_acquire(FuriMutex *mutex, uint32_t timeout);
+FuriStatus furi_mutex_release(FuriMutex *mutex);
+
+// Event flags
+typedef struct FuriEventFlag FuriEventFlag;
+FuriEventFlag *furi_event_flag_alloc(void);
+void furi_event_flag_free(FuriEventFlag *instance);
+uint32_t furi_event_flag_set(FuriEventFlag *instance, uint32_t flags);
+uint32_t furi_event_flag_clear(FuriEventFlag *instance, uint32_t flags);
+uint32_t furi_event_flag_get(FuriEventFlag *instance);
+uint32_t furi_event_flag_wait(FuriEventFlag *instance, uint32_t flags, uint32_t options, uint32_t timeout);
+
+// Message queue
+typedef struct FuriMessageQueue FuriMessageQueue;
+FuriMessageQueue *furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size);
+void furi_message_queue_free(FuriMessageQueue *instance);
+FuriStatus furi_message_queue_put(FuriMessageQueue *instance, const void *msg_ptr, uint32_t timeout);
+FuriStatus furi_message_queue_get(FuriMessageQueue *instance, void *msg_ptr, uint32_t timeout);
+uint32_t furi_message_queue_get_count(FuriMessageQueue *instance);
+
+// Stream buffer
+typedef struct FuriStreamBuffer FuriStreamBuffer;
+FuriStreamBuffer *furi_stream_buffer_alloc(size_t size, size_t trigger_level);
+void furi_stream_buffer_free(FuriStreamBuffer *stream_buffer);
+size_t furi_stream_buffer_send(FuriStreamBuffer *stream_buffer, const void *data, size_t length, uint32_t timeout);
+size_t furi_stream_buffer_receive(FuriStreamBuffer *stream_buffer, void *data, size_t length, uint32_t timeout);
+size_t furi_stream_buffer_bytes_available(FuriStreamBuffer *stream_buffer);
+size_t furi_stream_buffer_spaces_available(FuriStreamBuffer *stream_buffer);
+bool furi_stream_buffer_is_empty(FuriStreamBuffer *stream_buffer);
+FuriStatus furi_stream_buffer_reset(FuriStreamBuffer *stream_buffer);
+
+// Timers, all run on one timer thread like the firmware's
+typedef struct FuriTimer FuriTimer;
+typedef void (*FuriTimerCallback)(void *context);
+typedef enum
+{
+    FuriTimerTypeOnce = 0,
+    FuriTimerTypePeriodic = 1,
+} FuriTimerType;
+typedef enum
+{
+    FuriTimerThreadPriorityNormal,
+    FuriTimerThreadPriorityElevated,
+} FuriTimerThreadPriority;
+FuriTimer *furi_timer_alloc(FuriTimerCallback func, FuriTimerType type, void *context);
+void furi_timer_free(FuriTimer *instance);
+FuriStatus furi_timer_start(FuriTimer *instance, uint32_t ticks);
+FuriStatus furi_timer_restart(FuriTimer *instance, uint32_t ticks);
+FuriStatus furi_timer_stop(FuriTimer *instance);
+uint32_t furi_timer_is_running(FuriTimer *instance);
+void furi_timer_set_thread_priority(FuriTimerThreadPriority priority);
@@ -0,0 +1,10 @@
+// Description: Host stand-in for furi_hal.h
+// License: MIT
+// File: test/furi/furi_hal.h
+#pragma once
+#include <furi.h>
+#include <furi_hal_serial.h>
+#include <datetime/datetime.h>
+
+void furi_hal_rtc_get_datetime(DateTime *datetime);
+uint32_t furi_hal_rtc_get_timestamp(void);
@@ -0,0 +1,5 @@
+// Description: Host stand-in for furi_hal_gpio.h, nothing in the tested modules uses the GPIO directly
+// License: MIT
+// File: test/furi/furi_hal_gpio.h
+#pragma once
+#include <furi.h>
@@ -0,0 +1,44 @@
+// Description: Host stand-in for furi_hal_serial.h, backed by test/shim/serial_shim.c or test/shim/serial_pty.c
+// License: MIT
+// File: test/furi/furi_hal_serial.h
+#pragma once
+#include <furi.h>
+
+typedef struct FuriHalSerialHandle FuriHalSerialHandle;
+
+typedef enum
+{
+    FuriHalSerialIdUsart,
+    FuriHalSerialIdLpuart,
+} FuriHalSerialId;
+
+typedef enum
+{
+    FuriHalSerialDirectionTx,
+    FuriHalSerialDirectionRx,
+} FuriHalSerialDirection;
+
+typedef enum
+{
+    FuriHalSerialRxEventData = (1 << 0),
+    FuriHalSerialRxEventIdle = (1 << 1),
+    FuriHalSerialRxEventFrameError = (1 << 2),
+    FuriHalSerialRxEventNoiseError = (1 << 3),
+    FuriHalSerialRxEventOverrunError = (1 << 4),
+} FuriHalSerialRxEvent;
+
+typedef void (*FuriHalSerialDmaRxCallback)(FuriHalSerialHandle *handle, FuriHalSerialRxEvent event, size_t data_len, void *context);
+
+bool furi_hal_serial_control_is_busy(FuriHalSerialId serial_id);
+FuriHalSerialHandle *furi_hal_serial_control_acquire(FuriHalSerialId serial_id);
+void furi_hal_serial_control_release(FuriHalSerialHandle *handle);
+void furi_hal_serial_init(FuriHalSerialHandle *handle, uint32_t baud);
+void furi_hal_serial_deinit(FuriHalSerialHandle *handle);
+void furi_hal_serial_set_br(FuriHalSerialHandle *handle, uint32_t baud);
+void furi_hal_serial_enable_direction(FuriHalSerialHandle *handle, FuriHalSerialDirection direction);
+void furi_hal_serial_disable_direction(FuriHalSerialHandle *handle, FuriHalSerialDirection direction);
+void furi_hal_serial_tx(FuriHalSerialHandle *handle, const uint8_t *buffer, size_t buffer_size);
+void furi_hal_serial_tx_wait_complete(FuriHalSerialHandle *handle);
+void furi_hal_serial_dma_rx_start(FuriHalSerialHandle *handle, FuriHalSerialDmaRxCallback callback, void *context, bool report_errors);
+void furi_hal_serial_dma_rx_stop(FuriHalSerialHandle *handle);
+size_t furi_hal_serial_dma_rx(FuriHalSerialHandle *handle, uint8_t *data, size_t len);
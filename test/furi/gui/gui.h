@@ -0,0 +1,7 @@
+// Description: Host stand-in for gui/gui.h
+// License: MIT
+// File: test/furi/gui/gui.h
+#pragma once
+#include <furi.h>
+
+typedef struct Gui Gui;
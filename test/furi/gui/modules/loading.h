@@ -0,0 +1,12 @@
+// Description: Host stand-in for gui/modules/loading.h
+// License: MIT
+// File: test/furi/gui/modules/loading.h
+#pragma once
+#include <furi.h>
+#include <gui/view.h>
+
+typedef struct Loading Loading;
+
+Loading *loading_alloc(void);
+void loading_free(Loading *instance);
+View *loading_get_view(Loading *instance);
@@ -0,0 +1,7 @@
+// Description: Host stand-in for gui/view.h, only what flipper_http.h needs
+// License: MIT
+// File: test/furi/gui/view.h
+#pragma once
+#include <furi.h>
+
+typedef struct View View;
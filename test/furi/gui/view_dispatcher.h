@@ -0,0 +1,13 @@
+// Description: Host stand-in for gui/view_dispatcher.h, backed by test/shim/gui_shim.c
+// License: MIT
+// File: test/furi/gui/view_dispatcher.h
+#pragma once
+#include <furi.h>
+#include <gui/view.h>
+
+typedef struct ViewDispatcher ViewDispatcher;
+
+void view_dispatcher_add_view(ViewDispatcher *view_dispatcher, uint32_t view_id, View *view);
+void view_dispatcher_remove_view(ViewDispatcher *view_dispatcher, uint32_t view_id);
+void view_dispatcher_switch_to_view(ViewDispatcher *view_dispatcher, uint32_t view_id);
+void view_dispatcher_send_custom_event(ViewDispatcher *view_dispatcher, uint32_t event);
@@ -0,0 +1,59 @@
+// Description: Host stand-in for storage/storage.h, backed by the host filesystem in test/shim/storage_shim.c
+// License: MIT
+// File: test/furi/storage/storage.h
+#pragma once
+#include <furi.h>
+
+#define STORAGE_EXT_PATH_PREFIX "/ext"
+
+typedef struct Storage Storage;
+typedef struct File File;
+
+typedef enum
+{
+    FSAM_READ = (1 << 0),
+    FSAM_WRITE = (1 << 1),
+    FSAM_READ_WRITE = FSAM_READ | FSAM_WRITE,
+} FS_AccessMode;
+
+typedef enum
+{
+    FSOM_OPEN_EXISTING = 1,
+    FSOM_OPEN_ALWAYS = 2,
+    FSOM_OPEN_APPEND = 4,
+    FSOM_CREATE_NEW = 8,
+    FSOM_CREATE_ALWAYS = 16,
+} FS_OpenMode;
+
+typedef enum
+{
+    FSE_OK,
+    FSE_NOT_READY,
+    FSE_EXIST,
+    FSE_NOT_EXIST,
+    FSE_INVALID_PARAMETER,
+    FSE_DENIED,
+    FSE_INTERNAL,
+} FS_Error;
+
+File *storage_file_alloc(Storage *storage);
+void storage_file_free(File *file);
+bool storage_file_open(File *file, const char *path, FS_AccessMode access_mode, FS_OpenMode open_mode);
+bool storage_file_close(File *file);
+bool storage_file_is_open(File *file);
+size_t storage_file_read(File *file, void *buff, size_t bytes_to_read);
+size_t storage_file_write(File *file, const void *buff, size_t bytes_to_write);
+bool storage_file_seek(File *file, uint32_t offset, bool from_start);
+uint64_t storage_file_tell(File *file);
+uint64_t storage_file_size(File *file);
+bool storage_file_truncate(File *file);
+bool storage_file_sync(File *file);
+bool storage_file_eof(File *file);
+FS_Error storage_file_get_error(File *file);
+bool storage_file_exists(Storage *storage, const char *path);
+bool storage_simply_remove(Storage *storage, const char *path);
+bool storage_simply_remove_recursive(Storage *storage, const char *path);
+bool storage_simply_mkdir(Storage *storage, const char *path);
+FS_Error storage_common_mkdir(Storage *storage, const char *path);
+FS_Error storage_common_remove(Storage *storage, const char *path);
+FS_Error storage_common_rename(Storage *storage, const char *old_path, const char *new_path);
@@ -0,0 +1,1064 @@
+// Description: pthread-based stand-in for the Furi kernel pieces the app's portable modules use
+// License: MIT
+// File: test/shim/furi_shim.c
+#define _GNU_SOURCE
+#include <shim/shim.h>
+#include <furi_hal.h>
+#include <pthread.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Kernel
+
+static uint64_t furi_shim_start_ns;
+
+uint64_t furi_shim_now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+uint64_t furi_shim_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return furi_shim_now_ns();
+#endif
+}
+
+__attribute__((constructor)) static void furi_shim_init(void)
+{
+    furi_shim_start_ns = furi_shim_now_ns();
+}
+
+uint32_t furi_get_tick(void)
+{
+    return (uint32_t)((furi_shim_now_ns() - furi_shim_start_ns) / 1000000ull);
+}
+
+uint32_t furi_kernel_get_tick_frequency(void)
+{
+    return 1000;
+}
+
+uint32_t furi_ms_to_ticks(uint32_t milliseconds)
+{
+    return milliseconds;
+}
+
+void furi_delay_ms(uint32_t milliseconds)
+{
+    usleep(milliseconds * 1000u);
+}
+
+size_t memmgr_get_free_heap(void)
+{
+    return 128 * 1024;
+}
+
+void furi_shim_log(const char *level, const char *tag, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "[%s][%s] ", level, tag);
+    vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+void furi_shim_crash(const char *file, int line, const char *expression)
+{
+    fprintf(stderr, "%s:%d: furi_check failed: %s\n", file, line, expression);
+    abort();
+}
+
+static pthread_mutex_t furi_shim_critical = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+void furi_shim_critical_enter(void)
+{
+    pthread_mutex_lock(&furi_shim_critical);
+}
+
+void furi_shim_critical_exit(void)
+{
+    pthread_mutex_unlock(&furi_shim_critical);
+}
+
+// Absolute CLOCK_REALTIME deadline for a timeout in milliseconds, for the pthread timed waits
+static void furi_shim_deadline(struct timespec *deadline, uint32_t timeout)
+{
+    clock_gettime(CLOCK_REALTIME, deadline);
+    deadline->tv_sec += timeout / 1000;
+    deadline->tv_nsec += (long)(timeout % 1000) * 1000000L;
+    if (deadline->tv_nsec >= 1000000000L)
+    {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+// Wait on a condition until woken or the timeout passes, returning false on timeout
+static bool furi_shim_cond_wait(pthread_cond_t *cond, pthread_mutex_t *mutex, uint32_t timeout, const struct timespec *deadline)
+{
+    if (timeout == FuriWaitForever)
+    {
+        pthread_cond_wait(cond, mutex);
+        return true;
+    }
+    return pthread_cond_timedwait(cond, mutex, deadline) != ETIMEDOUT;
+}
+
+// Records
+
+static int furi_shim_record;
+
+void *furi_record_open(const char *name)
+{
+    UNUSED(name);
+    return &furi_shim_record;
+}
+
+void furi_record_close(const char *name)
+{
+    UNUSED(name);
+}
+
+// Strings
+
+struct FuriString
+{
+    char *data;
+    size_t size;
+    size_t capacity;
+};
+
+volatile size_t furi_shim_string_get_char_calls;
+
+void furi_string_reserve(FuriString *string, size_t size)
+{
+    if (size + 1 <= string->capacity)
+    {
+        return;
+    }
+    string->capacity = size + 1;
+    string->data = realloc(string->data, string->capacity);
+    furi_check(string->data);
+}
+
+FuriString *furi_string_alloc(void)
+{
+    FuriString *string = calloc(1, sizeof(FuriString));
+    furi_check(string);
+    furi_string_reserve(string, 15);
+    string->data[0] = '\0';
+    return string;
+}
+
+FuriString *furi_string_alloc_set_str(const char *cstr)
+{
+    FuriString *string = furi_string_alloc();
+    furi_string_set_str(string, cstr);
+    return string;
+}
+
+FuriString *furi_string_alloc_set(const FuriString *source)
+{
+    return furi_string_alloc_set_str(source->data);
+}
+
+void furi_string_free(FuriString *string)
+{
+    free(string->data);
+    free(string);
+}
+
+void furi_string_reset(FuriString *string)
+{
+    string->size = 0;
+    string->data[0] = '\0';
+}
+
+size_t furi_string_size(const FuriString *string)
+{
+    return string->size;
+}
+
+const char *furi_string_get_cstr(const FuriString *string)
+{
+    return string->data;
+}
+
+char furi_string_get_char(const FuriString *string, size_t index)
+{
+    furi_shim_string_get_char_calls++;
+    furi_check(index < string->size);
+    return string->data[index];
+}
+
+void furi_string_set_strn(FuriString *string, const char *cstr, size_t n)
+{
+    furi_string_reserve(string, n);
+    memmove(string->data, cstr, n);
+    string->data[n] = '\0';
+    string->size = n;
+}
+
+void furi_string_set_str(FuriString *string, const char *cstr)
+{
+    furi_string_set_strn(string, cstr, strlen(cstr));
+}
+
+void furi_string_set(FuriString *string, FuriString *source)
+{
+    furi_string_set_strn(string, source->data, source->size);
+}
+
+void furi_string_set_n(FuriString *string, const FuriString *source, size_t offset, size_t length)
+{
+    furi_check(offset <= source->size);
+    if (length > source->size - offset)
+    {
+        length = source->size - offset;
+    }
+    furi_string_set_strn(string, source->data + offset, length);
+}
+
+static void furi_string_cat_strn(FuriString *string, const char *cstr, size_t n)
+{
+    if (string->size + n + 1 > string->capacity)
+    {
+        // Grow geometrically like m-string so appending a character at a time stays linear
+        size_t capacity = string->capacity * 2;
+        furi_string_reserve(string, capacity > string->size + n ? capacity : string->size + n);
+    }
+    memcpy(string->data + string->size, cstr, n);
+    string->size += n;
+    string->data[string->size] = '\0';
+}
+
+void furi_string_cat(FuriString *string, const FuriString *source)
+{
+    furi_string_cat_strn(string, source->data, source->size);
+}
+
+void furi_string_cat_str(FuriString *string, const char *cstr)
+{
+    furi_string_cat_strn(string, cstr, strlen(cstr));
+}
+
+void furi_string_push_back(FuriString *string, char c)
+{
+    furi_string_cat_strn(string, &c, 1);
+}
+
+static int furi_string_vcat_printf(FuriString *string, const char *format, va_list args)
+{
+    va_list copy;
+    va_copy(copy, args);
+    int length = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    if (length < 0)
+    {
+        return length;
+    }
+    furi_string_reserve(string, string->size + (size_t)length);
+    vsnprintf(string->data + string->size, (size_t)length + 1, format, args);
+    string->size += (size_t)length;
+    return length;
+}
+
+int furi_string_cat_printf(FuriString *string, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int length = furi_string_vcat_printf(string, format, args);
+    va_end(args);
+    return length;
+}
+
+int furi_string_printf(FuriString *string, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    furi_string_reset(string);
+    int length = furi_string_vcat_printf(string, format, args);
+    va_end(args);
+    return length;
+}
+
+void furi_string_left(FuriString *string, size_t index)
+{
+    if (index < string->size)
+    {
+        string->size = index;
+        string->data[index] = '\0';
+    }
+}
+
+void furi_string_right(FuriString *string, size_t index)
+{
+    if (index >= string->size)
+    {
+        furi_string_reset(string);
+        return;
+    }
+    memmove(string->data, string->data + index, string->size - index + 1);
+    string->size -= index;
+}
+
+void furi_string_mid(FuriString *string, size_t index, size_t size)
+{
+    furi_string_right(string, index);
+    furi_string_left(string, size);
+}
+
+void furi_string_trim(FuriString *string)
+{
+    const char *spaces = " \n\r\t";
+    size_t start = 0;
+    size_t end = string->size;
+    while (start < end && strchr(spaces, string->data[start]))
+    {
+        start++;
+    }
+    while (end > start && strchr(spaces, string->data[end - 1]))
+    {
+        end--;
+    }
+    memmove(string->data, string->data + start, end - start);
+    string->size = end - start;
+    string->data[string->size] = '\0';
+}
+
+int furi_string_cmp(const FuriString *string_1, const FuriString *string_2)
+{
+    return strcmp(string_1->data, string_2->data);
+}
+
+int furi_string_cmp_str(const FuriString *string, const char *cstr)
+{
+    return strcmp(string->data, cstr);
+}
+
+bool furi_string_equal_str(const FuriString *string, const char *cstr)
+{
+    return strcmp(string->data, cstr) == 0;
+}
+
+size_t furi_string_search_str(const FuriString *string, const char *needle, size_t start)
+{
+    if (start > string->size)
+    {
+        return FURI_STRING_FAILURE;
+    }
+    const char *found = strstr(string->data + start, needle);
+    return found ? (size_t)(found - string->data) : FURI_STRING_FAILURE;
+}
+
+size_t furi_string_search_char(const FuriString *string, char c, size_t start)
+{
+    if (start > string->size)
+    {
+        return FURI_STRING_FAILURE;
+    }
+    const char *found = memchr(string->data + start, c, string->size - start);
+    return found ? (size_t)(found - string->data) : FURI_STRING_FAILURE;
+}
+
+FuriString *shim_load_file(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        return NULL;
+    }
+    FuriString *string = furi_string_alloc();
+    char buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        furi_string_cat_strn(string, buffer, read);
+    }
+    fclose(file);
+    return string;
+}
+
+// Threads and thread flags
+
+struct FuriThread
+{
+    pthread_t handle;
+    FuriThreadCallback callback;
+    void *context;
+    bool started;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t flags;
+};
+
+// Threads the shim did not start (main, the serial and timer threads) get their flags from a thread-local record
+static __thread FuriThread *furi_shim_current;
+
+static void furi_thread_init(FuriThread *thread)
+{
+    pthread_mutex_init(&thread->mutex, NULL);
+    pthread_cond_init(&thread->cond, NULL);
+}
+
+static void *furi_thread_body(void *context)
+{
+    FuriThread *thread = context;
+    furi_shim_current = thread;
+    thread->callback(thread->context);
+    return NULL;
+}
+
+FuriThread *furi_thread_alloc(void)
+{
+    FuriThread *thread = calloc(1, sizeof(FuriThread));
+    furi_check(thread);
+    furi_thread_init(thread);
+    return thread;
+}
+
+FuriThread *furi_thread_alloc_ex(const char *name, uint32_t stack_size, FuriThreadCallback callback, void *context)
+{
+    FuriThread *thread = furi_thread_alloc();
+    furi_thread_set_name(thread, name);
+    furi_thread_set_stack_size(thread, stack_size);
+    thread->callback = callback;
+    thread->context = context;
+    return thread;
+}
+
+void furi_thread_free(FuriThread *thread)
+{
+    pthread_cond_destroy(&thread->cond);
+    pthread_mutex_destroy(&thread->mutex);
+    free(thread);
+}
+
+void furi_thread_set_name(FuriThread *thread, const char *name)
+{
+    UNUSED(thread);
+    UNUSED(name);
+}
+
+// Host stacks are far larger than the device's; stack use is checked with -fstack-usage instead
+void furi_thread_set_stack_size(FuriThread *thread, size_t stack_size)
+{
+    UNUSED(thread);
+    UNUSED(stack_size);
+}
+
+void furi_thread_set_context(FuriThread *thread, void *context)
+{
+    thread->context = context;
+}
+
+void furi_thread_set_callback(FuriThread *thread, FuriThreadCallback callback)
+{
+    thread->callback = callback;
+}
+
+void furi_thread_set_priority(FuriThread *thread, FuriThreadPriority priority)
+{
+    UNUSED(thread);
+    UNUSED(priority);
+}
+
+void furi_thread_start(FuriThread *thread)
+{
+    furi_check(thread->callback);
+    furi_check(pthread_create(&thread->handle, NULL, furi_thread_body, thread) == 0);
+    thread->started = true;
+}
+
+bool furi_thread_join(FuriThread *thread)
+{
+    if (thread->started)
+    {
+        pthread_join(thread->handle, NULL);
+        thread->started = false;
+    }
+    return true;
+}
+
+FuriThreadId furi_thread_get_id(FuriThread *thread)
+{
+    return thread;
+}
+
+FuriThreadId furi_thread_get_current_id(void)
+{
+    if (!furi_shim_current)
+    {
+        furi_shim_current = furi_thread_alloc(); // Kept for the life of the host thread
+    }
+    return furi_shim_current;
+}
+
+uint32_t furi_thread_flags_set(FuriThreadId thread_id, uint32_t flags)
+{
+    FuriThread *thread = thread_id;
+    pthread_mutex_lock(&thread->mutex);
+    thread->flags |= flags;
+    uint32_t result = thread->flags;
+    pthread_cond_broadcast(&thread->cond);
+    pthread_mutex_unlock(&thread->mutex);
+    return result;
+}
+
+uint32_t furi_thread_flags_clear(uint32_t flags)
+{
+    FuriThread *thread = furi_thread_get_current_id();
+    pthread_mutex_lock(&thread->mutex);
+    uint32_t result = thread->flags;
+    thread->flags &= ~flags;
+    pthread_mutex_unlock(&thread->mutex);
+    return result;
+}
+
+uint32_t furi_thread_flags_get(void)
+{
+    FuriThread *thread = furi_thread_get_current_id();
+    pthread_mutex_lock(&thread->mutex);
+    uint32_t result = thread->flags;
+    pthread_mutex_unlock(&thread->mutex);
+    return result;
+}
+
+// Shared by thread flags and event flags, called with the mutex guarding *value held
+static uint32_t furi_shim_flags_wait(
+    uint32_t *value,
+    pthread_cond_t *cond,
+    pthread_mutex_t *mutex,
+    uint32_t flags,
+    uint32_t options,
+    uint32_t timeout)
+{
+    struct timespec deadline;
+    furi_shim_deadline(&deadline, timeout);
+    for (;;)
+    {
+        uint32_t set = *value & flags;
+        if ((options & FuriFlagWaitAll) ? set == flags : set != 0)
+        {
+            if (!(options & FuriFlagNoClear))
+            {
+                *value &= ~flags;
+            }
+            return set;
+        }
+        if (timeout == 0 || !furi_shim_cond_wait(cond, mutex, timeout, &deadline))
+        {
+            return FuriFlagErrorTimeout;
+        }
+    }
+}
+
+uint32_t furi_thread_flags_wait(uint32_t flags, uint32_t options, uint32_t timeout)
+{
+    FuriThread *thread = furi_thread_get_current_id();
+    pthread_mutex_lock(&thread->mutex);
+    uint32_t result = furi_shim_flags_wait(&thread->flags, &thread->cond, &thread->mutex, flags, options, timeout);
+    pthread_mutex_unlock(&thread->mutex);
+    return result;
+}
+
+// Mutex
+
+struct FuriMutex
+{
+    pthread_mutex_t mutex;
+};
+
+FuriMutex *furi_mutex_alloc(FuriMutexType type)
+{
+    FuriMutex *mutex = calloc(1, sizeof(FuriMutex));
+    furi_check(mutex);
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    if (type == FuriMutexTypeRecursive)
+    {
+        pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+    }
+    pthread_mutex_init(&mutex->mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+    return mutex;
+}
+
+void furi_mutex_free(FuriMutex *mutex)
+{
+    pthread_mutex_destroy(&mutex->mutex);
+    free(mutex);
+}
+
+FuriStatus furi_mutex_acquire(FuriMutex *mutex, uint32_t timeout)
+{
+    if (timeout == FuriWaitForever)
+    {
+        return pthread_mutex_lock(&mutex->mutex) == 0 ? FuriStatusOk : FuriStatusError;
+    }
+    struct timespec deadline;
+    furi_shim_deadline(&deadline, timeout);
+    return pthread_mutex_timedlock(&mutex->mutex, &deadline) == 0 ? FuriStatusOk : FuriStatusErrorTimeout;
+}
+
+FuriStatus furi_mutex_release(FuriMutex *mutex)
+{
+    return pthread_mutex_unlock(&mutex->mutex) == 0 ? FuriStatusOk : FuriStatusError;
+}
+
+// Event flags
+
+struct FuriEventFlag
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t flags;
+};
+
+FuriEventFlag *furi_event_flag_alloc(void)
+{
+    FuriEventFlag *instance = calloc(1, sizeof(FuriEventFlag));
+    furi_check(instance);
+    pthread_mutex_init(&instance->mutex, NULL);
+    pthread_cond_init(&instance->cond, NULL);
+    return instance;
+}
+
+void furi_event_flag_free(FuriEventFlag *instance)
+{
+    pthread_cond_destroy(&instance->cond);
+    pthread_mutex_destroy(&instance->mutex);
+    free(instance);
+}
+
+uint32_t furi_event_flag_set(FuriEventFlag *instance, uint32_t flags)
+{
+    pthread_mutex_lock(&instance->mutex);
+    instance->flags |= flags;
+    uint32_t result = instance->flags;
+    pthread_cond_broadcast(&instance->cond);
+    pthread_mutex_unlock(&instance->mutex);
+    return result;
+}
+
+uint32_t furi_event_flag_clear(FuriEventFlag *instance, uint32_t flags)
+{
+    pthread_mutex_lock(&instance->mutex);
+    uint32_t result = instance->flags;
+    instance->flags &= ~flags;
+    pthread_mutex_unlock(&instance->mutex);
+    return result;
+}
+
+uint32_t furi_event_flag_get(FuriEventFlag *instance)
+{
+    pthread_mutex_lock(&instance->mutex);
+    uint32_t result = instance->flags;
+    pthread_mutex_unlock(&instance->mutex);
+    return result;
+}
+
+uint32_t furi_event_flag_wait(FuriEventFlag *instance, uint32_t flags, uint32_t options, uint32_t timeout)
+{
+    pthread_mutex_lock(&instance->mutex);
+    uint32_t result = furi_shim_flags_wait(&instance->flags, &instance->cond, &instance->mutex, flags, options, timeout);
+    pthread_mutex_unlock(&instance->mutex);
+    return result;
+}
+
+// Message queue
+
+struct FuriMessageQueue
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint8_t *messages;
+    uint32_t capacity;
+    uint32_t message_size;
+    uint32_t head;
+    uint32_t count;
+};
+
+FuriMessageQueue *furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size)
+{
+    FuriMessageQueue *instance = calloc(1, sizeof(FuriMessageQueue));
+    furi_check(instance);
+    instance->messages = malloc((size_t)msg_count * msg_size);
+    furi_check(instance->messages);
+    instance->capacity = msg_count;
+    instance->message_size = msg_size;
+    pthread_mutex_init(&instance->mutex, NULL);
+    pthread_cond_init(&instance->cond, NULL);
+    return instance;
+}
+
+void furi_message_queue_free(FuriMessageQueue *instance)
+{
+    pthread_cond_destroy(&instance->cond);
+    pthread_mutex_destroy(&instance->mutex);
+    free(instance->messages);
+    free(instance);
+}
+
+FuriStatus furi_message_queue_put(FuriMessageQueue *instance, const void *msg_ptr, uint32_t timeout)
+{
+    struct timespec deadline;
+    furi_shim_deadline(&deadline, timeout);
+    pthread_mutex_lock(&instance->mutex);
+    while (instance->count == instance->capacity)
+    {
+        if (timeout == 0 || !furi_shim_cond_wait(&instance->cond, &instance->mutex, timeout, &deadline))
+        {
+            pthread_mutex_unlock(&instance->mutex);
+            return FuriStatusErrorTimeout;
+        }
+    }
+    uint32_t slot = (instance->head + instance->count) % instance->capacity;
+    memcpy(instance->messages + (size_t)slot * instance->message_size, msg_ptr, instance->message_size);
+    instance->count++;
+    pthread_cond_broadcast(&instance->cond);
+    pthread_mutex_unlock(&instance->mutex);
+    return FuriStatusOk;
+}
+
+FuriStatus furi_message_queue_get(FuriMessageQueue *instance, void *msg_ptr, uint32_t timeout)
+{
+    struct timespec deadline;
+    furi_shim_deadline(&deadline, timeout);
+    pthread_mutex_lock(&instance->mutex);
+    while (instance->count == 0)
+    {
+        if (timeout == 0 || !furi_shim_cond_wait(&instance->cond, &instance->mutex, timeout, &deadline))
+        {
+            pthread_mutex_unlock(&instance->mutex);
+            return FuriStatusErrorTimeout;
+        }
+    }
+    memcpy(msg_ptr, instance->messages + (size_t)instance->head * instance->message_size, instance->message_size);
+    instance->head = (instance->head + 1) % instance->capacity;
+    instance->count--;
+    pthread_cond_broadcast(&instance->cond);
+    pthread_mutex_unlock(&instance->mutex);
+    return FuriStatusOk;
+}
+
+uint32_t furi_message_queue_get_count(FuriMessageQueue *instance)
+{
+    pthread_mutex_lock(&instance->mutex);
+    uint32_t count = instance->count;
+    pthread_mutex_unlock(&instance->mutex);
+    return count;
+}
+
+// Stream buffer
+
+struct FuriStreamBuffer
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint8_t *data;
+    size_t capacity;
+    size_t head;
+    size_t length;
+};
+
+FuriStreamBuffer *furi_stream_buffer_alloc(size_t size, size_t trigger_level)
+{
+    UNUSED(trigger_level);
+    FuriStreamBuffer *stream_buffer = calloc(1, sizeof(FuriStreamBuffer));
+    furi_check(stream_buffer);
+    stream_buffer->data = malloc(size);
+    furi_check(stream_buffer->data);
+    stream_buffer->capacity = size;
+    pthread_mutex_init(&stream_buffer->mutex, NULL);
+    pthread_cond_init(&stream_buffer->cond, NULL);
+    return stream_buffer;
+}
+
+void furi_stream_buffer_free(FuriStreamBuffer *stream_buffer)
+{
+    pthread_cond_destroy(&stream_buffer->cond);
+    pthread_mutex_destroy(&stream_buffer->mutex);
+    free(stream_buffer->data);
+    free(stream_buffer);
+}
+
+// Only the RX interrupt sends, always with a zero timeout, so sending never blocks
+size_t furi_stream_buffer_send(FuriStreamBuffer *stream_buffer, const void *data, size_t length, uint32_t timeout)
+{
+    UNUSED(timeout);
+    const uint8_t *bytes = data;
+    pthread_mutex_lock(&stream_buffer->mutex);
+    size_t sent = 0;
+    while (sent < length && stream_buffer->length < stream_buffer->capacity)
+    {
+        size_t tail = (stream_buffer->head + stream_buffer->length) % stream_buffer->capacity;
+        size_t run = MIN(stream_buffer->capacity - tail, stream_buffer->capacity - stream_buffer->length);
+        run = MIN(run, length - sent);
+        memcpy(stream_buffer->data + tail, bytes + sent, run);
+        stream_buffer->length += run;
+        sent += run;
+    }
+    if (sent)
+    {
+        pthread_cond_broadcast(&stream_buffer->cond);
+    }
+    pthread_mutex_unlock(&stream_buffer->mutex);
+    return sent;
+}
+
+size_t furi_stream_buffer_receive(FuriStreamBuffer *stream_buffer, void *data, size_t length, uint32_t timeout)
+{
+    struct timespec deadline;
+    furi_shim_deadline(&deadline, timeout);
+    uint8_t *bytes = data;
+    pthread_mutex_lock(&stream_buffer->mutex);
+    while (stream_buffer->length == 0)
+    {
+        if (timeout == 0 || !furi_shim_cond_wait(&stream_buffer->cond, &stream_buffer->mutex, timeout, &deadline))
+        {
+            pthread_mutex_unlock(&stream_buffer->mutex);
+            return 0;
+        }
+    }
+    size_t received = 0;
+    while (received < length && stream_buffer->length > 0)
+    {
+        size_t run = MIN(stream_buffer->length, stream_buffer->capacity - stream_buffer->head);
+        run = MIN(run, length - received);
+        memcpy(bytes + received, stream_buffer->data + stream_buffer->head, run);
+        stream_buffer->head = (stream_buffer->head + run) % stream_buffer->capacity;
+        stream_buffer->length -= run;
+        received += run;
+    }
+    pthread_mutex_unlock(&stream_buffer->mutex);
+    return received;
+}
+
+size_t furi_stream_buffer_bytes_available(FuriStreamBuffer *stream_buffer)
+{
+    pthread_mutex_lock(&stream_buffer->mutex);
+    size_t length = stream_buffer->length;
+    pthread_mutex_unlock(&stream_buffer->mutex);
+    return length;
+}
+
+size_t furi_stream_buffer_spaces_available(FuriStreamBuffer *stream_buffer)
+{
+    pthread_mutex_lock(&stream_buffer->mutex);
+    size_t spaces = stream_buffer->capacity - stream_buffer->length;
+    pthread_mutex_unlock(&stream_buffer->mutex);
+    return spaces;
+}
+
+bool furi_stream_buffer_is_empty(FuriStreamBuffer *stream_buffer)
+{
+    return furi_stream_buffer_bytes_available(stream_buffer) == 0;
+}
+
+FuriStatus furi_stream_buffer_reset(FuriStreamBuffer *stream_buffer)
+{
+    pthread_mutex_lock(&stream_buffer->mutex);
+    stream_buffer->head = 0;
+    stream_buffer->length = 0;
+    pthread_mutex_unlock(&stream_buffer->mutex);
+    return FuriStatusOk;
+}
+
+// Timers
+
+struct FuriTimer
+{
+    FuriTimerCallback callback;
+    FuriTimerType type;
+    void *context;
+    uint32_t period;
+    uint64_t deadline_ns; // Next expiry while running
+    bool running;
+    FuriTimer *next;      // Next timer in furi_shim_timers
+};
+
+static pthread_mutex_t furi_shim_timer_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t furi_shim_timer_cond = PTHREAD_COND_INITIALIZER;
+static FuriTimer *furi_shim_timers;  // Every allocated timer
+static FuriTimer *furi_shim_firing;  // Timer whose callback the timer thread is running
+static pthread_t furi_shim_timer_thread;
+static bool furi_shim_timer_thread_started;
+
+static void *furi_shim_timer_body(void *context)
+{
+    UNUSED(context);
+    pthread_mutex_lock(&furi_shim_timer_mutex);
+    for (;;)
+    {
+        FuriTimer *earliest = NULL;
+        for (FuriTimer *timer = furi_shim_timers; timer; timer = timer->next)
+        {
+            if (timer->running && (!earliest || timer->deadline_ns < earliest->deadline_ns))
+            {
+                earliest = timer;
+            }
+        }
+        if (!earliest)
+        {
+            pthread_cond_wait(&furi_shim_timer_cond, &furi_shim_timer_mutex);
+            continue;
+        }
+        uint64_t now = furi_shim_now_ns();
+        if (earliest->deadline_ns > now)
+        {
+            // Sleep until the earliest expiry, or until a timer is started, stopped or freed
+            struct timespec deadline;
+            furi_shim_deadline(&deadline, (uint32_t)((earliest->deadline_ns - now + 999999ull) / 1000000ull));
+            pthread_cond_timedwait(&furi_shim_timer_cond, &furi_shim_timer_mutex, &deadline);
+            continue;
+        }
+        if (earliest->type == FuriTimerTypePeriodic)
+        {
+            earliest->deadline_ns += (uint64_t)earliest->period * 1000000ull;
+        }
+        else
+        {
+            earliest->running = false;
+        }
+        // Callbacks run unlocked so they can start and stop timers, as on the firmware's timer thread
+        furi_shim_firing = earliest;
+        pthread_mutex_unlock(&furi_shim_timer_mutex);
+        earliest->callback(earliest->context);
+        pthread_mutex_lock(&furi_shim_timer_mutex);
+        furi_shim_firing = NULL;
+        pthread_cond_broadcast(&furi_shim_timer_cond);
+    }
+    return NULL;
+}
+
+FuriTimer *furi_timer_alloc(FuriTimerCallback func, FuriTimerType type, void *context)
+{
+    FuriTimer *instance = calloc(1, sizeof(FuriTimer));
+    furi_check(instance);
+    instance->callback = func;
+    instance->type = type;
+    instance->context = context;
+    pthread_mutex_lock(&furi_shim_timer_mutex);
+    if (!furi_shim_timer_thread_started)
+    {
+        pthread_attr_t attributes;
+        pthread_attr_init(&attributes);
+        pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+        furi_check(pthread_create(&furi_shim_timer_thread, &attributes, furi_shim_timer_body, NULL) == 0);
+        pthread_attr_destroy(&attributes);
+        furi_shim_timer_thread_started = true;
+    }
+    instance->next = furi_shim_timers;
+    furi_shim_timers = instance;
+    pthread_mutex_unlock(&furi_shim_timer_mutex);
+    return instance;
+}
+
+void furi_timer_free(FuriTimer *instance)
+{
+    pthread_mutex_lock(&furi_shim_timer_mutex);
+    // Like the firmware, wait for a callback that is already running to return
+    while (furi_shim_firing == instance && !pthread_equal(pthread_self(), furi_shim_timer_thread))
+    {
+        pthread_cond_wait(&furi_shim_timer_cond, &furi_shim_timer_mutex);
+    }
+    for (FuriTimer **link = &furi_shim_timers; *link; link = &(*link)->next)
+    {
+        if (*link == instance)
+        {
+            *link = instance->next;
+            break;
+        }
+    }
+    pthread_cond_broadcast(&furi_shim_timer_cond);
+    pthread_mutex_unlock(&furi_shim_timer_mutex);
+    free(instance);
+}
+
+FuriStatus furi_timer_start(FuriTimer *instance, uint32_t ticks)
+{
+    pthread_mutex_lock(&furi_shim_timer_mutex);
+    instance->period = ticks;
+    instance->deadline_ns = furi_shim_now_ns() + (uint64_t)ticks * 1000000ull;
+    instance->running = true;
+    pthread_cond_broadcast(&furi_shim_timer_cond);
+    pthread_mutex_unlock(&furi_shim_timer_mutex);
+    return FuriStatusOk;
+}
+
+FuriStatus furi_timer_restart(FuriTimer *instance, uint32_t ticks)
+{
+    return furi_timer_start(instance, ticks);
+}
+
+FuriStatus furi_timer_stop(FuriTimer *instance)
+{
+    pthread_mutex_lock(&furi_shim_timer_mutex);
+    instance->running = false;
+    pthread_cond_broadcast(&furi_shim_timer_cond);
+    pthread_mutex_unlock(&furi_shim_timer_mutex);
+    return FuriStatusOk;
+}
+
+uint32_t furi_timer_is_running(FuriTimer *instance)
+{
+    pthread_mutex_lock(&furi_shim_timer_mutex);
+    uint32_t running = instance->running;
+    pthread_mutex_unlock(&furi_shim_timer_mutex);
+    return running;
+}
+
+void furi_timer_set_thread_priority(FuriTimerThreadPriority priority)
+{
+    UNUSED(priority);
+}
+
+// RTC
+
+uint32_t furi_hal_rtc_get_timestamp(void)
+{
+    return (uint32_t)time(NULL);
+}
+
+void furi_hal_rtc_get_datetime(DateTime *datetime)
+{
+    datetime_timestamp_to_datetime(furi_hal_rtc_get_timestamp(), datetime);
+}
+
+uint32_t datetime_datetime_to_timestamp(DateTime *datetime)
+{
+    struct tm parts = {
+        .tm_year = datetime->year - 1900,
+        .tm_mon = datetime->month - 1,
+        .tm_mday = datetime->day,
+        .tm_hour = datetime->hour,
+        .tm_min = datetime->minute,
+        .tm_sec = datetime->second,
+    };
+    return (uint32_t)timegm(&parts);
+}
+
+void datetime_timestamp_to_datetime(uint32_t timestamp, DateTime *datetime)
+{
+    time_t seconds = timestamp;
+    struct tm parts;
+    gmtime_r(&seconds, &parts);
+    datetime->year = (uint16_t)(parts.tm_year + 1900);
+    datetime->month = (uint8_t)(parts.tm_mon + 1);
+    datetime->day = (uint8_t)parts.tm_mday;
+    datetime->hour = (uint8_t)parts.tm_hour;
+    datetime->minute = (uint8_t)parts.tm_min;
+    datetime->second = (uint8_t)parts.tm_sec;
+    datetime->weekday = (uint8_t)(parts.tm_wday == 0 ? 7 : parts.tm_wday);
+}
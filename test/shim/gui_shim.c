@@ -0,0 +1,61 @@
+// Description: The few GUI calls flipper_http.c makes; custom events are handed to a test hook
+// License: MIT
+// File: test/shim/gui_shim.c
+#include <shim/shim.h>
+#include <gui/view_dispatcher.h>
+#include <gui/modules/loading.h>
+
+static GuiShimCustomEventHook gui_shim_custom_event_hook;
+static void *gui_shim_custom_event_context;
+
+void gui_shim_set_custom_event_hook(GuiShimCustomEventHook hook, void *context)
+{
+    gui_shim_custom_event_hook = hook;
+    gui_shim_custom_event_context = context;
+}
+
+void view_dispatcher_send_custom_event(ViewDispatcher *view_dispatcher, uint32_t event)
+{
+    UNUSED(view_dispatcher);
+    if (gui_shim_custom_event_hook)
+    {
+        gui_shim_custom_event_hook(event, gui_shim_custom_event_context);
+    }
+}
+
+void view_dispatcher_add_view(ViewDispatcher *view_dispatcher, uint32_t view_id, View *view)
+{
+    UNUSED(view_dispatcher);
+    UNUSED(view_id);
+    UNUSED(view);
+}
+
+void view_dispatcher_remove_view(ViewDispatcher *view_dispatcher, uint32_t view_id)
+{
+    UNUSED(view_dispatcher);
+    UNUSED(view_id);
+}
+
+void view_dispatcher_switch_to_view(ViewDispatcher *view_dispatcher, uint32_t view_id)
+{
+    UNUSED(view_dispatcher);
+    UNUSED(view_id);
+}
+
+static int gui_shim_loading;
+
+Loading *loading_alloc(void)
+{
+    return (Loading *)&gui_shim_loading;
+}
+
+void loading_free(Loading *instance)
+{
+    UNUSED(instance);
+}
+
+View *loading_get_view(Loading *instance)
+{
+    UNUSED(instance);
+    return NULL;
+}
@@ -0,0 +1,185 @@
+// Description: The UART on a pseudo-terminal: the app's side is the slave, the test plays the board on the master
+// License: MIT
+// File: test/shim/serial_pty.c
+//
+// Linked instead of serial_shim.c. A reader thread plays the DMA: whatever arrives on the slave is reported
+// to the app's callback as one idle event. The rate set with furi_hal_serial_init and furi_hal_serial_set_br
+// is only recorded (serial_shim_baudrate), so the board decides what a rate mismatch does to the bytes.
+#define _GNU_SOURCE
+#include <shim/shim.h>
+#include <pthread.h>
+#include <pty.h>
+#include <sys/select.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define SERIAL_PTY_DMA_SIZE 512 // Most bytes reported per DMA event
+#define SERIAL_PTY_POLL_MS 20   // How often the reader thread checks whether it should stop
+
+struct FuriHalSerialHandle
+{
+    int master;
+    int slave;
+    _Atomic uint32_t baudrate;
+    pthread_t reader;
+    _Atomic bool reading;
+    FuriHalSerialDmaRxCallback callback;
+    void *context;
+    uint8_t dma_data[SERIAL_PTY_DMA_SIZE]; // Bytes of the DMA event being reported
+    size_t dma_len;                        // Bytes of the event
+    size_t dma_pos;                        // Bytes of the event taken with furi_hal_serial_dma_rx
+};
+
+static FuriHalSerialHandle serial_pty_handle = {.master = -1, .slave = -1};
+
+uint32_t serial_shim_baudrate(void)
+{
+    return serial_pty_handle.baudrate;
+}
+
+int serial_pty_master(void)
+{
+    return serial_pty_handle.master;
+}
+
+void serial_pty_close(void)
+{
+    if (serial_pty_handle.slave >= 0)
+    {
+        close(serial_pty_handle.slave);
+        serial_pty_handle.slave = -1;
+    }
+    if (serial_pty_handle.master >= 0)
+    {
+        close(serial_pty_handle.master);
+        serial_pty_handle.master = -1;
+    }
+}
+
+static void serial_pty_make_raw(int fd)
+{
+    struct termios termios;
+    tcgetattr(fd, &termios);
+    cfmakeraw(&termios);
+    tcsetattr(fd, TCSANOW, &termios);
+}
+
+static void *serial_pty_reader(void *context)
+{
+    FuriHalSerialHandle *handle = context;
+    while (handle->reading)
+    {
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(handle->slave, &readable);
+        struct timeval timeout = {0, SERIAL_PTY_POLL_MS * 1000};
+        if (select(handle->slave + 1, &readable, NULL, NULL, &timeout) <= 0)
+        {
+            continue;
+        }
+        ssize_t received = read(handle->slave, handle->dma_data, sizeof(handle->dma_data));
+        if (received <= 0)
+        {
+            continue;
+        }
+        handle->dma_len = (size_t)received;
+        handle->dma_pos = 0;
+        handle->callback(handle, FuriHalSerialRxEventData | FuriHalSerialRxEventIdle, handle->dma_len, handle->context);
+    }
+    return NULL;
+}
+
+bool furi_hal_serial_control_is_busy(FuriHalSerialId serial_id)
+{
+    UNUSED(serial_id);
+    return false;
+}
+
+FuriHalSerialHandle *furi_hal_serial_control_acquire(FuriHalSerialId serial_id)
+{
+    UNUSED(serial_id);
+    return &serial_pty_handle;
+}
+
+void furi_hal_serial_control_release(FuriHalSerialHandle *handle)
+{
+    UNUSED(handle);
+}
+
+// Opens a new pty; the one of a previous connection must have been closed with serial_pty_close
+void furi_hal_serial_init(FuriHalSerialHandle *handle, uint32_t baud)
+{
+    furi_check(handle->master < 0);
+    furi_check(openpty(&handle->master, &handle->slave, NULL, NULL, NULL) == 0);
+    serial_pty_make_raw(handle->master);
+    serial_pty_make_raw(handle->slave);
+    handle->baudrate = baud;
+}
+
+// The pty stays open so the board can still read what was sent last; serial_pty_close closes it
+void furi_hal_serial_deinit(FuriHalSerialHandle *handle)
+{
+    UNUSED(handle);
+}
+
+void furi_hal_serial_set_br(FuriHalSerialHandle *handle, uint32_t baud)
+{
+    handle->baudrate = baud;
+}
+
+void furi_hal_serial_enable_direction(FuriHalSerialHandle *handle, FuriHalSerialDirection direction)
+{
+    UNUSED(handle);
+    UNUSED(direction);
+}
+
+void furi_hal_serial_disable_direction(FuriHalSerialHandle *handle, FuriHalSerialDirection direction)
+{
+    UNUSED(handle);
+    UNUSED(direction);
+}
+
+void furi_hal_serial_tx(FuriHalSerialHandle *handle, const uint8_t *buffer, size_t buffer_size)
+{
+    while (buffer_size > 0)
+    {
+        ssize_t written = write(handle->slave, buffer, buffer_size);
+        furi_check(written > 0);
+        buffer += written;
+        buffer_size -= (size_t)written;
+    }
+}
+
+void furi_hal_serial_tx_wait_complete(FuriHalSerialHandle *handle)
+{
+    tcdrain(handle->slave);
+}
+
+void furi_hal_serial_dma_rx_start(FuriHalSerialHandle *handle, FuriHalSerialDmaRxCallback callback, void *context, bool report_errors)
+{
+    UNUSED(report_errors);
+    handle->callback = callback;
+    handle->context = context;
+    handle->reading = true;
+    furi_check(pthread_create(&handle->reader, NULL, serial_pty_reader, handle) == 0);
+}
+
+void furi_hal_serial_dma_rx_stop(FuriHalSerialHandle *handle)
+{
+    if (!handle->reading)
+    {
+        return;
+    }
+    handle->reading = false;
+    pthread_join(handle->reader, NULL);
+    handle->callback = NULL;
+    handle->context = NULL;
+}
+
+size_t furi_hal_serial_dma_rx(FuriHalSerialHandle *handle, uint8_t *data, size_t len)
+{
+    size_t copy_len = MIN(len, handle->dma_len - handle->dma_pos);
+    memcpy(data, &handle->dma_data[handle->dma_pos], copy_len);
+    handle->dma_pos += copy_len;
+    return copy_len;
+}
@@ -0,0 +1,137 @@
+// Description: In-process UART: the test plays the board by calling serial_shim_receive and watching the TX hook
+// License: MIT
+// File: test/shim/serial_shim.c
+#include <shim/shim.h>
+#include <pthread.h>
+
+#define SERIAL_SHIM_DMA_SIZE 256 // Bytes reported per DMA event, like a half-full DMA buffer on the device
+
+struct FuriHalSerialHandle
+{
+    uint32_t baudrate;
+    FuriHalSerialDmaRxCallback callback;
+    void *context;
+    const uint8_t *dma_data; // Bytes of the DMA event being reported
+    size_t dma_len;          // Bytes of the event not yet taken with furi_hal_serial_dma_rx
+};
+
+static FuriHalSerialHandle serial_shim_handle;
+static pthread_mutex_t serial_shim_rx_mutex = PTHREAD_MUTEX_INITIALIZER;
+static SerialShimTxHook serial_shim_tx_hook;
+static void *serial_shim_tx_context;
+
+void serial_shim_set_tx_hook(SerialShimTxHook hook, void *context)
+{
+    serial_shim_tx_hook = hook;
+    serial_shim_tx_context = context;
+}
+
+uint32_t serial_shim_baudrate(void)
+{
+    return serial_shim_handle.baudrate;
+}
+
+// Runs the app's DMA callback on the calling thread, which plays the RX interrupt
+void serial_shim_receive(const uint8_t *data, size_t data_size)
+{
+    pthread_mutex_lock(&serial_shim_rx_mutex);
+    while (data_size > 0 && serial_shim_handle.callback)
+    {
+        size_t len = data_size < SERIAL_SHIM_DMA_SIZE ? data_size : SERIAL_SHIM_DMA_SIZE;
+        FuriHalSerialRxEvent event = FuriHalSerialRxEventData;
+        if (len == data_size)
+        {
+            event |= FuriHalSerialRxEventIdle;
+        }
+        serial_shim_handle.dma_data = data;
+        serial_shim_handle.dma_len = len;
+        serial_shim_handle.callback(&serial_shim_handle, event, len, serial_shim_handle.context);
+        data += len;
+        data_size -= len;
+    }
+    pthread_mutex_unlock(&serial_shim_rx_mutex);
+}
+
+bool furi_hal_serial_control_is_busy(FuriHalSerialId serial_id)
+{
+    UNUSED(serial_id);
+    return false;
+}
+
+FuriHalSerialHandle *furi_hal_serial_control_acquire(FuriHalSerialId serial_id)
+{
+    UNUSED(serial_id);
+    return &serial_shim_handle;
+}
+
+void furi_hal_serial_control_release(FuriHalSerialHandle *handle)
+{
+    UNUSED(handle);
+}
+
+void furi_hal_serial_init(FuriHalSerialHandle *handle, uint32_t baud)
+{
+    handle->baudrate = baud;
+}
+
+void furi_hal_serial_deinit(FuriHalSerialHandle *handle)
+{
+    UNUSED(handle);
+}
+
+void furi_hal_serial_set_br(FuriHalSerialHandle *handle, uint32_t baud)
+{
+    handle->baudrate = baud;
+}
+
+void furi_hal_serial_enable_direction(FuriHalSerialHandle *handle, FuriHalSerialDirection direction)
+{
+    UNUSED(handle);
+    UNUSED(direction);
+}
+
+void furi_hal_serial_disable_direction(FuriHalSerialHandle *handle, FuriHalSerialDirection direction)
+{
+    UNUSED(handle);
+    UNUSED(direction);
+}
+
+void furi_hal_serial_tx(FuriHalSerialHandle *handle, const uint8_t *buffer, size_t buffer_size)
+{
+    UNUSED(handle);
+    if (serial_shim_tx_hook)
+    {
+        serial_shim_tx_hook(buffer, buffer_size, serial_shim_tx_context);
+    }
+}
+
+void furi_hal_serial_tx_wait_complete(FuriHalSerialHandle *handle)
+{
+    UNUSED(handle);
+}
+
+void furi_hal_serial_dma_rx_start(FuriHalSerialHandle *handle, FuriHalSerialDmaRxCallback callback, void *context, bool report_errors)
+{
+    UNUSED(report_errors);
+    pthread_mutex_lock(&serial_shim_rx_mutex);
+    handle->callback = callback;
+    handle->context = context;
+    pthread_mutex_unlock(&serial_shim_rx_mutex);
+}
+
+void furi_hal_serial_dma_rx_stop(FuriHalSerialHandle *handle)
+{
+    pthread_mutex_lock(&serial_shim_rx_mutex);
+    handle->callback = NULL;
+    handle->context = NULL;
+    pthread_mutex_unlock(&serial_shim_rx_mutex);
+}
+
+size_t furi_hal_serial_dma_rx(FuriHalSerialHandle *handle, uint8_t *data, size_t len)
+{
+    size_t copy_len = len < handle->dma_len ? len : handle->dma_len;
+    memcpy(data, handle->dma_data, copy_len);
+    handle->dma_data += copy_len;
+    handle->dma_len -= copy_len;
+    return copy_len;
+}
@@ -0,0 +1,40 @@
+// Description: Controls the host tests and benchmarks use to drive the Furi shim
+// License: MIT
+// File: test/shim/shim.h
+#pragma once
+#include <furi.h>
+#include <furi_hal_serial.h>
+#include <storage/storage.h>
+
+// Time and counters
+uint64_t furi_shim_now_ns(void);                       // Monotonic clock in nanoseconds
+uint64_t furi_shim_cycles(void);                       // CPU timestamp counter, or nanoseconds where there is none
+extern volatile size_t furi_shim_string_get_char_calls; // Calls to furi_string_get_char since start
+
+// Storage: called before every storage_file_write, e.g. to sleep like a slow SD card
+typedef void (*StorageShimWriteHook)(size_t bytes, void *context);
+void storage_shim_set_write_hook(StorageShimWriteHook hook, void *context);
+
+// Serial: serial_shim.c is an in-process UART, serial_pty.c puts the UART on a pseudo-terminal
+typedef void (*SerialShimTxHook)(const uint8_t *data, size_t data_size, void *context);
+void serial_shim_set_tx_hook(SerialShimTxHook hook, void *context); // Bytes the app sends to the board
+void serial_shim_receive(const uint8_t *data, size_t data_size);    // Bytes the board sends, delivered like a DMA idle event
+uint32_t serial_shim_baudrate(void);                                // Rate the app's side of the UART is set to
+int serial_pty_master(void);                                        // serial_pty.c: the board's end of the pty, -1 before init
+void serial_pty_close(void);                                        // serial_pty.c: close the pty once the board is done with it
+
+// GUI: called on the sending thread for every view_dispatcher_send_custom_event
+typedef void (*GuiShimCustomEventHook)(uint32_t event, void *context);
+void gui_shim_set_custom_event_hook(GuiShimCustomEventHook hook, void *context);
+
+// Shared helpers for the test programs
+FuriString *shim_load_file(const char *path); // Whole host file, or NULL
+#define SHIM_CHECK(failures, condition)                                                   \
+    do                                                                                    \
+    {                                                                                     \
+        if (!(condition))                                                                 \
+        {                                                                                 \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            (failures)++;                                                                 \
+        }                                                                                 \
+    } while (0)
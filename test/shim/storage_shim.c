@@ -0,0 +1,202 @@
+// Description: Storage API on the host filesystem; paths are used as they are
+// License: MIT
+// File: test/shim/storage_shim.c
+#define _GNU_SOURCE
+#include <shim/shim.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <ftw.h>
+
+struct File
+{
+    FILE *stream;
+    FS_Error error;
+};
+
+static StorageShimWriteHook storage_shim_write_hook;
+static void *storage_shim_write_context;
+
+void storage_shim_set_write_hook(StorageShimWriteHook hook, void *context)
+{
+    storage_shim_write_hook = hook;
+    storage_shim_write_context = context;
+}
+
+File *storage_file_alloc(Storage *storage)
+{
+    UNUSED(storage);
+    File *file = calloc(1, sizeof(File));
+    furi_check(file);
+    return file;
+}
+
+void storage_file_free(File *file)
+{
+    storage_file_close(file);
+    free(file);
+}
+
+bool storage_file_open(File *file, const char *path, FS_AccessMode access_mode, FS_OpenMode open_mode)
+{
+    bool exists = access(path, F_OK) == 0;
+    const char *mode;
+    switch (open_mode)
+    {
+    case FSOM_CREATE_NEW:
+        if (exists)
+        {
+            file->error = FSE_EXIST;
+            return false;
+        }
+        mode = (access_mode & FSAM_READ) ? "w+b" : "wb";
+        break;
+    case FSOM_CREATE_ALWAYS:
+        mode = (access_mode & FSAM_READ) ? "w+b" : "wb";
+        break;
+    case FSOM_OPEN_APPEND:
+        mode = (access_mode & FSAM_READ) ? "a+b" : "ab";
+        break;
+    case FSOM_OPEN_ALWAYS:
+        mode = exists ? ((access_mode & FSAM_WRITE) ? "r+b" : "rb") : "w+b";
+        break;
+    case FSOM_OPEN_EXISTING:
+    default:
+        mode = (access_mode & FSAM_WRITE) ? "r+b" : "rb";
+        break;
+    }
+    file->stream = fopen(path, mode);
+    file->error = file->stream ? FSE_OK : (exists ? FSE_DENIED : FSE_NOT_EXIST);
+    return file->stream != NULL;
+}
+
+bool storage_file_close(File *file)
+{
+    if (file->stream)
+    {
+        fclose(file->stream);
+        file->stream = NULL;
+    }
+    return true;
+}
+
+bool storage_file_is_open(File *file)
+{
+    return file->stream != NULL;
+}
+
+size_t storage_file_read(File *file, void *buff, size_t bytes_to_read)
+{
+    size_t read = fread(buff, 1, bytes_to_read, file->stream);
+    file->error = ferror(file->stream) ? FSE_INTERNAL : FSE_OK;
+    return read;
+}
+
+size_t storage_file_write(File *file, const void *buff, size_t bytes_to_write)
+{
+    if (storage_shim_write_hook)
+    {
+        storage_shim_write_hook(bytes_to_write, storage_shim_write_context);
+    }
+    size_t written = fwrite(buff, 1, bytes_to_write, file->stream);
+    file->error = written == bytes_to_write ? FSE_OK : FSE_INTERNAL;
+    return written;
+}
+
+bool storage_file_seek(File *file, uint32_t offset, bool from_start)
+{
+    return fseek(file->stream, (long)offset, from_start ? SEEK_SET : SEEK_CUR) == 0;
+}
+
+uint64_t storage_file_tell(File *file)
+{
+    return (uint64_t)ftell(file->stream);
+}
+
+uint64_t storage_file_size(File *file)
+{
+    long position = ftell(file->stream);
+    fseek(file->stream, 0, SEEK_END);
+    long size = ftell(file->stream);
+    fseek(file->stream, position, SEEK_SET);
+    return (uint64_t)size;
+}
+
+bool storage_file_truncate(File *file)
+{
+    fflush(file->stream);
+    return ftruncate(fileno(file->stream), ftell(file->stream)) == 0;
+}
+
+bool storage_file_sync(File *file)
+{
+    return fflush(file->stream) == 0;
+}
+
+bool storage_file_eof(File *file)
+{
+    return feof(file->stream) != 0;
+}
+
+FS_Error storage_file_get_error(File *file)
+{
+    return file->error;
+}
+
+bool storage_file_exists(Storage *storage, const char *path)
+{
+    UNUSED(storage);
+    struct stat info;
+    return stat(path, &info) == 0 && S_ISREG(info.st_mode);
+}
+
+bool storage_simply_remove(Storage *storage, const char *path)
+{
+    UNUSED(storage);
+    return remove(path) == 0 || access(path, F_OK) != 0;
+}
+
+static int storage_shim_remove_entry(const char *path, const struct stat *info, int type, struct FTW *ftw)
+{
+    UNUSED(info);
+    UNUSED(type);
+    UNUSED(ftw);
+    return remove(path);
+}
+
+bool storage_simply_remove_recursive(Storage *storage, const char *path)
+{
+    UNUSED(storage);
+    if (access(path, F_OK) != 0)
+    {
+        return true;
+    }
+    return nftw(path, storage_shim_remove_entry, 16, FTW_DEPTH | FTW_PHYS) == 0;
+}
+
+bool storage_simply_mkdir(Storage *storage, const char *path)
+{
+    FS_Error error = storage_common_mkdir(storage, path);
+    return error == FSE_OK || error == FSE_EXIST;
+}
+
+FS_Error storage_common_mkdir(Storage *storage, const char *path)
+{
+    UNUSED(storage);
+    if (mkdir(path, 0777) == 0)
+    {
+        return FSE_OK;
+    }
+    return access(path, F_OK) == 0 ? FSE_EXIST : FSE_NOT_EXIST;
+}
+
+FS_Error storage_common_remove(Storage *storage, const char *path)
+{
+    UNUSED(storage);
+    return remove(path) == 0 ? FSE_OK : FSE_NOT_EXIST;
+}
+
+FS_Error storage_common_rename(Storage *storage, const char *old_path, const char *new_path)
+{
+    UNUSED(storage);
+    return rename(old_path, new_path) == 0 ? FSE_OK : FSE_NOT_EXIST;
+}
@@ -0,0 +1,218 @@
+// Description: Baud rate negotiation and fallback against a board emulator on a pseudo-terminal
+// License: MIT
+// File: test/test_baud_pty.c
+//
+// flipper_http_alloc runs on shim/serial_pty.c and a board thread answers on the pty master like the
+// FlipperHTTP firmware: [PING] with [PONG], [BAUD] with [BAUD/OK] before switching, returning to BAUDRATE
+// when no PING follows within BAUD_FALLBACK_MS. Bytes sent while the two sides are set to different rates
+// arrive garbled, as on a real UART. Each scenario runs the loader's sequence (flipper_http_ping_wait, then
+// flipper_http_negotiate_baudrate), checks the link with another PING and frees the connection, which must
+// leave the board at BAUDRATE.
+#define _GNU_SOURCE
+#include <flipper_http/flipper_http.h>
+#include <shim/shim.h>
+#include <pthread.h>
+#include <sys/select.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define TEST_BOARD_POLL_MS 10   // How often the board checks its fallback deadline and whether to stop
+#define TEST_BOARD_SWITCH_MS 2  // Time the board takes to switch rates after sending [BAUD/OK]
+#define TEST_GARBLE 0x5A        // What a UART at the wrong rate makes of a byte, modelled as an XOR
+#define TEST_FREE_WAIT_MS 200   // Time the board has to handle the [BAUD] flipper_http_free sends
+
+typedef struct
+{
+    const char *name;
+    uint32_t max_baudrate; // Fastest rate the firmware accepts, 0 for firmware without [BAUD]
+    uint32_t broken_at;    // Rates from this one up garble even when both sides agree (bad wiring), 0 for none
+    bool silent;           // No board attached
+    uint32_t expected;     // Rate the negotiation must end at
+} TestScenario;
+
+typedef struct
+{
+    const TestScenario *scenario;
+    int fd;                    // pty master
+    _Atomic uint32_t baudrate; // Rate the board is set to
+    _Atomic bool running;
+    uint64_t fallback_ns;      // When the board returns to BAUDRATE without a PING, 0 for never
+} TestBoard;
+
+static bool test_board_link_ok(TestBoard *board)
+{
+    return board->baudrate == serial_shim_baudrate() &&
+           !(board->scenario->broken_at && board->baudrate >= board->scenario->broken_at);
+}
+
+static void test_board_send(TestBoard *board, const char *line)
+{
+    char buffer[128];
+    size_t len = strlen(line);
+    memcpy(buffer, line, len);
+    buffer[len++] = '\n';
+    if (!test_board_link_ok(board))
+    {
+        for (size_t i = 0; i < len; i++)
+        {
+            buffer[i] ^= TEST_GARBLE;
+        }
+    }
+    furi_check(write(board->fd, buffer, len) == (ssize_t)len);
+}
+
+static void test_board_command(TestBoard *board, const char *line)
+{
+    if (strcmp(line, "[PING]") == 0)
+    {
+        board->fallback_ns = 0;
+        test_board_send(board, "[PONG]");
+    }
+    else if (strncmp(line, "[BAUD]", 6) == 0 && board->scenario->max_baudrate)
+    {
+        const char *value = strstr(line, "\"baudrate\":");
+        unsigned long baudrate = value ? strtoul(value + strlen("\"baudrate\":"), NULL, 10) : 0;
+        if (baudrate == 0 || baudrate > board->scenario->max_baudrate)
+        {
+            test_board_send(board, "[ERROR] Unsupported baudrate.");
+            return;
+        }
+        // The answer goes out at the old rate, then the board listens at the new one
+        test_board_send(board, "[BAUD/OK]");
+        tcdrain(board->fd);
+        furi_delay_ms(TEST_BOARD_SWITCH_MS);
+        board->baudrate = (uint32_t)baudrate;
+        board->fallback_ns = baudrate == BAUDRATE ? 0 : furi_shim_now_ns() + BAUD_FALLBACK_MS * 1000000ull;
+    }
+    else
+    {
+        test_board_send(board, "[ERROR] Unknown command.");
+    }
+}
+
+static void *test_board_thread(void *context)
+{
+    TestBoard *board = context;
+    char line[512];
+    size_t len = 0;
+    while (board->running)
+    {
+        if (board->fallback_ns && furi_shim_now_ns() >= board->fallback_ns)
+        {
+            board->baudrate = BAUDRATE;
+            board->fallback_ns = 0;
+        }
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(board->fd, &readable);
+        struct timeval timeout = {0, TEST_BOARD_POLL_MS * 1000};
+        uint8_t byte;
+        if (select(board->fd + 1, &readable, NULL, NULL, &timeout) <= 0 || read(board->fd, &byte, 1) != 1)
+        {
+            continue;
+        }
+        if (board->scenario->silent)
+        {
+            continue;
+        }
+        if (!test_board_link_ok(board))
+        {
+            byte ^= TEST_GARBLE;
+        }
+        if (byte == FLOW_XON || byte == FLOW_XOFF)
+        {
+            continue;
+        }
+        if (byte != '\n')
+        {
+            if (len < sizeof(line) - 1)
+            {
+                line[len++] = (char)byte;
+            }
+            continue;
+        }
+        line[len] = '\0';
+        len = 0;
+        test_board_command(board, line);
+    }
+    return NULL;
+}
+
+static int test_scenario(const TestScenario *scenario)
+{
+    int failures = 0;
+    FlipperHTTP *fhttp = flipper_http_alloc();
+    furi_check(fhttp);
+    SHIM_CHECK(failures, fhttp->baudrate == BAUDRATE);
+    SHIM_CHECK(failures, serial_shim_baudrate() == BAUDRATE);
+
+    TestBoard board = {.scenario = scenario, .fd = serial_pty_master(), .baudrate = BAUDRATE, .running = true};
+    pthread_t board_thread;
+    furi_check(pthread_create(&board_thread, NULL, test_board_thread, &board) == 0);
+
+    // The loader's connect sequence
+    uint64_t start = furi_shim_now_ns();
+    bool pong = flipper_http_ping_wait(fhttp, PING_TIMEOUT_MS);
+    uint64_t pinged = furi_shim_now_ns();
+    bool faster = flipper_http_negotiate_baudrate(fhttp);
+    uint64_t negotiated = furi_shim_now_ns();
+
+    // The link must work at whatever rate was settled on
+    bool pong_after = flipper_http_ping_wait(fhttp, PING_TIMEOUT_MS);
+    uint32_t baudrate = serial_shim_baudrate();
+    uint32_t board_baudrate = board.baudrate;
+
+    flipper_http_free(fhttp);
+    for (uint32_t waited = 0; board.baudrate != BAUDRATE && waited < TEST_FREE_WAIT_MS; waited++)
+    {
+        furi_delay_ms(1);
+    }
+    uint32_t board_after_free = board.baudrate;
+    board.running = false;
+    pthread_join(board_thread, NULL);
+    serial_pty_close();
+
+    printf("%-22s %8lu %8lu %9.1f %11.1f %6s %10lu\n",
+           scenario->name,
+           (unsigned long)baudrate,
+           (unsigned long)board_baudrate,
+           (double)(pinged - start) / 1e6,
+           (double)(negotiated - pinged) / 1e6,
+           pong_after ? "yes" : "no",
+           (unsigned long)board_after_free);
+
+    SHIM_CHECK(failures, pong == !scenario->silent);
+    SHIM_CHECK(failures, faster == (scenario->expected != BAUDRATE));
+    SHIM_CHECK(failures, baudrate == scenario->expected);
+    SHIM_CHECK(failures, board_after_free == BAUDRATE);
+    if (!scenario->silent)
+    {
+        SHIM_CHECK(failures, board_baudrate == scenario->expected);
+        SHIM_CHECK(failures, pong_after);
+    }
+    else
+    {
+        // A missing board costs at most one BAUD_TIMEOUT_MS on top of the PING timeout
+        SHIM_CHECK(failures, negotiated - pinged <= (BAUD_TIMEOUT_MS + 100) * 1000000ull);
+    }
+    return failures;
+}
+
+int main(void)
+{
+    static const TestScenario scenarios[] = {
+        {"board up to 460800", 460800, 0, false, 460800},
+        {"board up to 230400", 230400, 0, false, 230400},
+        {"firmware without BAUD", 0, 0, false, BAUDRATE},
+        {"460800 link broken", 460800, 460800, false, 230400},
+        {"no board", 460800, 0, true, BAUDRATE},
+    };
+    int failures = 0;
+    printf("%-22s %8s %8s %9s %11s %6s %10s\n", "scenario", "flipper", "board", "ping ms", "negotiate ms", "ping", "after free");
+    for (size_t i = 0; i < COUNT_OF(scenarios); i++)
+    {
+        failures += test_scenario(&scenarios[i]);
+    }
+    printf(failures ? "FAILED (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,207 @@
+// Description: A binary response saved at 115200 baud while SD writes stall, without losing a byte
+// License: MIT
+// File: test/test_file_writer_stress.c
+//
+// flipper_http_alloc runs on the serial shim. The test plays the board: it answers a GET/BYTES request
+// with TEST_PAYLOAD_SIZE bytes at the pace of 115200 baud, in DMA bursts, while the storage write hook
+// makes every 4th SD write stall TEST_SLOW_WRITE_MS and the others take TEST_FAST_WRITE_MS. No flow
+// control is negotiated, so a worker that falls behind loses bytes at the 2 KB stream buffer.
+//   writer thread  the built-in file sink, whose writer thread does the SD writes
+//   inline         a sink writing each 2 KB buffer on the worker, as the file sink did before it had a writer
+// The writer thread must save the payload exactly; the inline sink shows the stalls are long enough to drop bytes.
+#include <flipper_http/flipper_http.c>
+#include <shim/shim.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#define TEST_PAYLOAD_SIZE (48 * 1024) // Bytes of the response body
+#define TEST_BYTES_PER_SECOND 11520   // 115200 baud, 8N1
+#define TEST_DMA_BURST 64             // Bytes per DMA event
+#define TEST_SLOW_WRITE_MS 300        // Every 4th SD write stalls this long
+#define TEST_FAST_WRITE_MS 15         // The other SD writes take this long
+#define TEST_TIMEOUT_MS 10000         // Longest wait for the response to complete after the last byte
+
+static atomic_uint test_writes;
+
+static void test_slow_storage(size_t bytes, void *context)
+{
+    UNUSED(bytes);
+    UNUSED(context);
+    unsigned writes = atomic_fetch_add(&test_writes, 1) + 1;
+    furi_delay_ms(writes % 4 == 0 ? TEST_SLOW_WRITE_MS : TEST_FAST_WRITE_MS);
+}
+
+// Binary body with line breaks; NUL bytes are left out, in line mode they hide the end marker (frames carry them)
+static uint8_t test_payload_byte(size_t index)
+{
+    uint8_t byte = (uint8_t)((index * 2654435761u) >> 13);
+    return byte ? byte : 0xFF;
+}
+
+// A sink that writes each full 2 KB buffer on the worker thread itself
+typedef struct
+{
+    const char *path;
+    File *file;
+    uint8_t buffer[FILE_SINK_BUFFER_SIZE];
+    size_t buffer_len;
+} TestInlineSink;
+
+static bool test_inline_open(void *context)
+{
+    TestInlineSink *sink = context;
+    sink->file = storage_file_alloc(NULL);
+    sink->buffer_len = 0;
+    return storage_file_open(sink->file, sink->path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+}
+
+static bool test_inline_write(const uint8_t *data, size_t data_size, void *context)
+{
+    TestInlineSink *sink = context;
+    bool success = true;
+    while (data_size > 0)
+    {
+        size_t copy_len = MIN(data_size, FILE_SINK_BUFFER_SIZE - sink->buffer_len);
+        memcpy(&sink->buffer[sink->buffer_len], data, copy_len);
+        sink->buffer_len += copy_len;
+        data += copy_len;
+        data_size -= copy_len;
+        if (sink->buffer_len == FILE_SINK_BUFFER_SIZE)
+        {
+            success = storage_file_write(sink->file, sink->buffer, sink->buffer_len) == sink->buffer_len && success;
+            sink->buffer_len = 0;
+        }
+    }
+    return success;
+}
+
+static bool test_inline_close(bool completed, void *context)
+{
+    UNUSED(completed);
+    TestInlineSink *sink = context;
+    bool success = storage_file_write(sink->file, sink->buffer, sink->buffer_len) == sink->buffer_len;
+    storage_file_free(sink->file);
+    sink->file = NULL;
+    return success;
+}
+
+// Send the response like the board: DMA bursts on the schedule of the baud rate, whether or not they fit
+static void test_play_response(void)
+{
+    static const char head[] = "[GET/SUCCESS] GET request successful.\n";
+    static const char end[] = "[GET/END]\n";
+    serial_shim_receive((const uint8_t *)head, sizeof(head) - 1);
+
+    uint8_t burst[TEST_DMA_BURST];
+    uint64_t start = furi_shim_now_ns();
+    for (size_t offset = 0; offset < TEST_PAYLOAD_SIZE; offset += TEST_DMA_BURST)
+    {
+        size_t len = MIN((size_t)TEST_DMA_BURST, TEST_PAYLOAD_SIZE - offset);
+        uint64_t due = start + (uint64_t)(offset + len) * 1000000000ull / TEST_BYTES_PER_SECOND;
+        uint64_t now = furi_shim_now_ns();
+        if (due > now)
+        {
+            usleep((useconds_t)((due - now) / 1000));
+        }
+        for (size_t i = 0; i < len; i++)
+        {
+            burst[i] = test_payload_byte(offset + i);
+        }
+        serial_shim_receive(burst, len);
+    }
+    serial_shim_receive((const uint8_t *)end, sizeof(end) - 1);
+}
+
+// Compare the saved file with the payload; returns the number of bytes saved
+static size_t test_saved_bytes(const char *path, bool *identical)
+{
+    FILE *file = fopen(path, "rb");
+    size_t saved = 0;
+    *identical = file != NULL;
+    int byte;
+    while (file && (byte = fgetc(file)) != EOF)
+    {
+        *identical = *identical && saved < TEST_PAYLOAD_SIZE && (uint8_t)byte == test_payload_byte(saved);
+        saved++;
+    }
+    if (file)
+    {
+        fclose(file);
+    }
+    *identical = *identical && saved == TEST_PAYLOAD_SIZE;
+    return saved;
+}
+
+int main(void)
+{
+    char path[] = "/tmp/test_file_writer_stress_XXXXXX";
+    int fd = mkstemp(path);
+    furi_check(fd >= 0);
+    close(fd);
+
+    FlipperHTTP *fhttp = flipper_http_alloc();
+    furi_check(fhttp);
+    fhttp->state = IDLE;
+    snprintf(fhttp->file_path, sizeof(fhttp->file_path), "%s", path);
+
+    TestInlineSink inline_sink = {.path = path};
+    const FlipperHTTPSink inline_sink_ops = {
+        .open = test_inline_open,
+        .write = test_inline_write,
+        .close = test_inline_close,
+        .context = &inline_sink,
+    };
+
+    int failures = 0;
+    printf("%-14s %9s %9s %9s %7s %10s\n", "sink", "sent", "saved", "dropped", "writes", "identical");
+    for (int run = 0; run < 2; run++)
+    {
+        bool writer_thread = run == 0;
+        if (writer_thread)
+        {
+            flipper_http_set_sink_file(fhttp);
+        }
+        else
+        {
+            flipper_http_set_sink(fhttp, &inline_sink_ops);
+        }
+
+        storage_shim_set_write_hook(test_slow_storage, NULL);
+        atomic_store(&test_writes, 0);
+        furi_event_flag_clear(fhttp->events, FlipperHTTPEvtComplete);
+        fhttp->is_bytes_request = true;
+        SHIM_CHECK(failures, flipper_http_get_request_bytes(fhttp, "https://example.com/firmware.bin", "{}"));
+        test_play_response();
+        uint32_t flags = furi_event_flag_wait(fhttp->events, FlipperHTTPEvtComplete, FuriFlagWaitAny, TEST_TIMEOUT_MS);
+        storage_shim_set_write_hook(NULL, NULL);
+
+        bool identical;
+        size_t saved = test_saved_bytes(path, &identical);
+        printf("%-14s %9d %9zu %9lu %7u %10s\n",
+               writer_thread ? "writer thread" : "inline",
+               TEST_PAYLOAD_SIZE,
+               saved,
+               (unsigned long)fhttp->request_dropped,
+               atomic_load(&test_writes),
+               identical ? "yes" : "no");
+
+        SHIM_CHECK(failures, !(flags & FuriFlagError));
+        SHIM_CHECK(failures, fhttp->active_request == FlipperHTTPRequestNone);
+        if (writer_thread)
+        {
+            SHIM_CHECK(failures, fhttp->request_dropped == 0);
+            SHIM_CHECK(failures, identical);
+        }
+        else
+        {
+            // Otherwise the stalls are too short to test anything; if the end marker was among the lost
+            // bytes, the response ends by timeout instead
+            SHIM_CHECK(failures, fhttp->request_dropped > 0);
+        }
+    }
+
+    flipper_http_free(fhttp);
+    unlink(path);
+    printf(failures ? "FAILED (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,310 @@
+// Description: How much text the BROWSE parsers recover from saved pages, and tag matching on small cases
+// License: MIT
+// File: test/test_html_corpus.c
+//
+// Each corpus page is parsed three ways:
+//   original  the exact-literal html_furi from test/baseline/, as BROWSE used it before tag matching changed
+//   extract   the current html_furi_extract fallback of web_crawler_parse
+//   stream    html_furi_stream fed in RX_CHUNK_SIZE pieces, the parser BROWSE runs while the page downloads
+// The page is also rewritten the way many sites write markup (<P class="text">, <TITLE>), which must not
+// change what the current parsers recover.
+#include <html/html_furi.h>
+#include <html/html_furi_stream.h>
+#include <baseline/html_furi_baseline.h>
+#include <shim/shim.h>
+
+#define TEST_STREAM_CHUNK 256    // Bytes fed to the stream parser at a time, like the UART worker's chunks
+#define TEST_STREAM_OUTPUT 8192  // Text kept by the stream parser, MAX_FILE_SHOW in the app
+#define TEST_MAX_MATCHES 512     // Enough for every paragraph of the largest corpus page
+
+typedef struct
+{
+    const char *file;    // Page in the corpus
+    const char *heading; // Heading text that must be recovered
+    size_t min_chars;    // Text characters the current parsers must recover
+} TestPage;
+
+static const char *test_browse_tags[] = {"<head>", "<title>", "<h1>", "<h2>", "<h3>", "<p>"};
+
+// Count the characters of text outside markup; the extract fallback keeps nested tags such as <a> and <code>
+static size_t test_text_chars(const char *text)
+{
+    size_t count = 0;
+    bool in_tag = false;
+    for (; *text; text++)
+    {
+        if (*text == '<')
+        {
+            in_tag = true;
+        }
+        else if (*text == '>')
+        {
+            in_tag = false;
+        }
+        else if (!in_tag && !isspace((unsigned char)*text))
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+// Remove markup so recovered text can be searched for a heading
+static void test_strip_tags(FuriString *text)
+{
+    FuriString *stripped = furi_string_alloc();
+    bool in_tag = false;
+    for (const char *c = furi_string_get_cstr(text); *c; c++)
+    {
+        if (*c == '<')
+        {
+            in_tag = true;
+        }
+        else if (*c == '>')
+        {
+            in_tag = false;
+        }
+        else if (!in_tag)
+        {
+            furi_string_push_back(stripped, *c);
+        }
+    }
+    furi_string_set(text, stripped);
+    furi_string_free(stripped);
+}
+
+// The BROWSE text before tag matching changed: exact "<tag>" literals only
+static FuriString *test_browse_original(FuriString *html)
+{
+    FuriString *response = furi_string_alloc();
+    if (!html_furi_baseline_tag_exists("<head>", html, 0))
+    {
+        return response;
+    }
+    for (size_t t = 1; t < COUNT_OF(test_browse_tags); t++)
+    {
+        FuriString *content = t == COUNT_OF(test_browse_tags) - 1 ? html_furi_baseline_find_tags(test_browse_tags[t], html)
+                                                                 : html_furi_baseline_find_tag(test_browse_tags[t], html, 0);
+        if (content)
+        {
+            // Normalized like the extract side, so decoded entities count the same on both
+            html_furi_normalize_string(content);
+            furi_string_cat(response, content);
+            furi_string_cat_str(response, "\n");
+            furi_string_free(content);
+        }
+    }
+    return response;
+}
+
+// The html_furi_extract fallback of web_crawler_parse
+static FuriString *test_browse_extract(FuriString *html)
+{
+    FuriString *response = furi_string_alloc();
+    HTMLFuriMatch matches[TEST_MAX_MATCHES];
+    size_t match_count = html_furi_extract(test_browse_tags, COUNT_OF(test_browse_tags), html, matches, COUNT_OF(matches));
+    FuriString *content = furi_string_alloc();
+    for (size_t t = 1; t < COUNT_OF(test_browse_tags); t++)
+    {
+        for (size_t m = 0; m < match_count; m++)
+        {
+            if (matches[m].tag_index != t)
+            {
+                continue;
+            }
+            furi_string_set_n(content, html, matches[m].start, matches[m].length);
+            html_furi_normalize_string(content);
+            furi_string_cat(response, content);
+            furi_string_cat_str(response, "\n");
+            if (t != COUNT_OF(test_browse_tags) - 1)
+            {
+                break;
+            }
+        }
+    }
+    furi_string_free(content);
+    return response;
+}
+
+// The stream parser as the UART worker feeds it
+static FuriString *test_browse_stream(FuriString *html, bool *head_found)
+{
+    HTMLFuriStream *stream = html_furi_stream_alloc(TEST_STREAM_OUTPUT);
+    furi_check(stream);
+    const uint8_t *data = (const uint8_t *)furi_string_get_cstr(html);
+    size_t size = furi_string_size(html);
+    for (size_t offset = 0; offset < size; offset += TEST_STREAM_CHUNK)
+    {
+        html_furi_stream_feed(data + offset, MIN(TEST_STREAM_CHUNK, size - offset), stream);
+    }
+    *head_found = stream->head_found;
+    FuriString *response = furi_string_alloc_set_str(html_furi_stream_get_text(stream));
+    html_furi_stream_free(stream);
+    return response;
+}
+
+// Replace every occurrence of `from` with `to`
+static void test_replace_all(FuriString *html, const char *from, const char *to)
+{
+    FuriString *result = furi_string_alloc();
+    const char *text = furi_string_get_cstr(html);
+    size_t from_len = strlen(from);
+    const char *found;
+    while ((found = strstr(text, from)) != NULL)
+    {
+        FuriString *part = furi_string_alloc();
+        furi_string_set_strn(part, text, found - text);
+        furi_string_cat(result, part);
+        furi_string_free(part);
+        furi_string_cat_str(result, to);
+        text = found + from_len;
+    }
+    furi_string_cat_str(result, text);
+    furi_string_set(html, result);
+    furi_string_free(result);
+}
+
+// The page written the way many sites write it: upper-case names and attributes on every paragraph
+static FuriString *test_site_variant(FuriString *html)
+{
+    FuriString *variant = furi_string_alloc_set(html);
+    test_replace_all(variant, "<head>", "<HEAD>");
+    test_replace_all(variant, "</head>", "</HEAD>");
+    test_replace_all(variant, "<title>", "<TITLE>");
+    test_replace_all(variant, "</title>", "</TITLE>");
+    test_replace_all(variant, "<p>", "<P class=\"text\">");
+    test_replace_all(variant, "</p>", "</P>");
+    return variant;
+}
+
+// Small cases for the tag matcher: case, attributes, self-closing tags and look-alike names
+static int test_tag_matching(void)
+{
+    static const struct
+    {
+        const char *html;
+        const char *tag;
+        const char *expected; // NULL if the tag must not be found
+    } cases[] = {
+        {"<html><P>Upper case</P></html>", "<p>", "Upper case"},
+        {"<p class=\"x\">With attributes</p>", "<p>", "With attributes"},
+        {"<h1 id=intro>Unquoted attribute</h1>", "<h1>", "Unquoted attribute"},
+        {"<p title='a>b'>Quoted bracket</p>", "<p>", "Quoted bracket"},
+        {"<pre>code</pre><param name=x><p>Paragraph</p>", "<p>", "Paragraph"},
+        {"<br/><p/><p>After self-closing</p>", "<p>", "After self-closing"},
+        {"<TITLE >Spaced</title >", "<title>", "Spaced"},
+        {"<div><p>Outer <b>bold</b></p></div>", "<p>", "Outer <b>bold</b>"},
+        {"<p>Nested <p>inner</p> outer</p>", "<p>", "Nested <p>inner</p> outer"},
+        {"<script>if (a<p) x('<p>');</script><p>After script</p>", "<p>", "After script"},
+        {"<pre>only pre</pre>", "<p>", NULL},
+    };
+    int failures = 0;
+    for (size_t i = 0; i < COUNT_OF(cases); i++)
+    {
+        FuriString *html = furi_string_alloc_set_str(cases[i].html);
+        FuriString *found = html_furi_find_tag(cases[i].tag, html, 0);
+        if (cases[i].expected == NULL)
+        {
+            SHIM_CHECK(failures, found == NULL);
+        }
+        else
+        {
+            SHIM_CHECK(failures, found != NULL && strcmp(furi_string_get_cstr(found), cases[i].expected) == 0);
+        }
+        if (found && (cases[i].expected == NULL || strcmp(furi_string_get_cstr(found), cases[i].expected) != 0))
+        {
+            fprintf(stderr, "  case %zu: got \"%s\"\n", i, furi_string_get_cstr(found));
+        }
+        if (found)
+        {
+            furi_string_free(found);
+        }
+        furi_string_free(html);
+    }
+
+    // The self-closing <p/> has no content, so every paragraph after it is still found
+    FuriString *html = furi_string_alloc_set_str("<p/><P class=a>One</P><br><p>Two</p>");
+    FuriString *all = html_furi_find_tags("<p>", html);
+    SHIM_CHECK(failures, strstr(furi_string_get_cstr(all), "One") && strstr(furi_string_get_cstr(all), "Two"));
+    furi_string_free(all);
+    furi_string_free(html);
+    return failures;
+}
+
+int main(int argc, char **argv)
+{
+    const char *corpus = argc > 1 ? argv[1] : "corpus";
+    static const TestPage pages[] = {
+        {"rustdoc-what-is-rustdoc.html", "What is rustdoc?", 2500},
+        {"rustc-lint-groups.html", "Lint Groups", 550},
+        {"book-installation.html", "Installation", 3800},
+        {"std-index.html", "Crate std", 4500},
+    };
+
+    int failures = test_tag_matching();
+
+    printf("%-30s %-9s %9s %9s %9s %9s\n", "page", "markup", "original", "extract", "stream", "heading");
+    for (size_t i = 0; i < COUNT_OF(pages); i++)
+    {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/%s", corpus, pages[i].file);
+        FuriString *page = shim_load_file(path);
+        if (!page)
+        {
+            fprintf(stderr, "Cannot read %s\n", path);
+            return 1;
+        }
+
+        FuriString *variant = test_site_variant(page);
+        size_t page_extract_chars = 0;
+        size_t page_stream_chars = 0;
+        for (int v = 0; v < 2; v++)
+        {
+            FuriString *html = v == 0 ? page : variant;
+            FuriString *original = test_browse_original(html);
+            FuriString *extract = test_browse_extract(html);
+            bool head_found = false;
+            FuriString *stream = test_browse_stream(html, &head_found);
+            size_t original_chars = test_text_chars(furi_string_get_cstr(original));
+            size_t extract_chars = test_text_chars(furi_string_get_cstr(extract));
+            size_t stream_chars = test_text_chars(furi_string_get_cstr(stream));
+
+            test_strip_tags(extract);
+            bool heading = strstr(furi_string_get_cstr(extract), pages[i].heading) &&
+                           strstr(furi_string_get_cstr(stream), pages[i].heading);
+            printf("%-30s %-9s %9zu %9zu %9zu %9s\n",
+                   v == 0 ? pages[i].file : "",
+                   v == 0 ? "as saved" : "site",
+                   original_chars,
+                   extract_chars,
+                   stream_chars,
+                   heading ? "found" : "MISSING");
+
+            SHIM_CHECK(failures, head_found);
+            SHIM_CHECK(failures, heading);
+            SHIM_CHECK(failures, extract_chars >= pages[i].min_chars);
+            SHIM_CHECK(failures, stream_chars >= pages[i].min_chars);
+            SHIM_CHECK(failures, extract_chars >= original_chars);
+            if (v == 0)
+            {
+                page_extract_chars = extract_chars;
+                page_stream_chars = stream_chars;
+            }
+            else
+            {
+                // Case and attributes must not change what is recovered
+                SHIM_CHECK(failures, extract_chars == page_extract_chars);
+                SHIM_CHECK(failures, stream_chars == page_stream_chars);
+            }
+
+            furi_string_free(stream);
+            furi_string_free(extract);
+            furi_string_free(original);
+        }
+        furi_string_free(variant);
+        furi_string_free(page);
+    }
+
+    printf(failures ? "FAILED (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
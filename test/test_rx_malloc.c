@@ -0,0 +1,226 @@
+// Description: Heap allocations per received line while a long response is replayed through the UART
+// License: MIT
+// File: test/test_rx_malloc.c
+//
+// A GET response of about 200 KB (lines of a saved rustdoc page) is played into flipper_http_alloc's
+// UART through the serial shim, and every malloc, calloc and realloc on any thread is counted while it
+// is received. The line handler must not allocate. The same replay with the original trim() run on
+// every line first gives the "before" figure.
+#include <flipper_http/flipper_http.c>
+#include <shim/shim.h>
+#include <stdatomic.h>
+
+#define TEST_RESPONSE_SIZE (200 * 1024) // Bytes of response body replayed
+#define TEST_TIMEOUT_MS 10000           // Longest wait for the response to complete
+
+// glibc's allocator, which the counting wrappers below pass every call on to
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *pointer, size_t size);
+
+static atomic_bool test_counting;
+static atomic_size_t test_allocations;
+
+// Replacing malloc in the program also catches the calls glibc makes itself, such as strdup's
+void *malloc(size_t size)
+{
+    if (atomic_load(&test_counting))
+    {
+        atomic_fetch_add(&test_allocations, 1);
+    }
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    if (atomic_load(&test_counting))
+    {
+        atomic_fetch_add(&test_allocations, 1);
+    }
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size)
+{
+    if (atomic_load(&test_counting))
+    {
+        atomic_fetch_add(&test_allocations, 1);
+    }
+    return __libc_realloc(pointer, size);
+}
+
+typedef struct
+{
+    FlipperHTTP *fhttp;
+    size_t lines;      // Lines handed to the line handler
+    size_t body_bytes; // Bytes the parser sink received
+} TestRx;
+
+// The trim() the line handler ran on every line before it stopped allocating, verbatim
+static char *test_original_trim(const char *str)
+{
+    const char *end;
+    char *trimmed_str;
+    size_t len;
+
+    // Trim leading space
+    while (isspace((unsigned char)*str))
+        str++;
+
+    // All spaces?
+    if (*str == 0)
+        return strdup(""); // Return an empty string if all spaces
+
+    // Trim trailing space
+    end = str + strlen(str) - 1;
+    while (end > str && isspace((unsigned char)*end))
+        end--;
+
+    // Set length for the trimmed string
+    len = end - str + 1;
+
+    // Allocate space for the trimmed string and null terminator
+    trimmed_str = (char *)malloc(len + 1);
+    if (trimmed_str == NULL)
+    {
+        return NULL; // Handle memory allocation failure
+    }
+
+    // Copy the trimmed part of the string into trimmed_str
+    strncpy(trimmed_str, str, len);
+    trimmed_str[len] = '\0'; // Null terminate the string
+
+    return trimmed_str;
+}
+
+static void test_current_line(const char *line, void *context)
+{
+    TestRx *rx = context;
+    rx->lines++;
+    flipper_http_rx_callback(line, rx->fhttp);
+}
+
+static void test_original_line(const char *line, void *context)
+{
+    TestRx *rx = context;
+    rx->lines++;
+    free(test_original_trim(line));
+    flipper_http_rx_callback(line, rx->fhttp);
+}
+
+static bool test_sink_parse(const uint8_t *data, size_t data_size, void *context)
+{
+    TestRx *rx = context;
+    UNUSED(data);
+    rx->body_bytes += data_size;
+    return true;
+}
+
+// Play the response like the board, never faster than the worker drains the stream buffer
+static void test_replay(FlipperHTTP *fhttp, const uint8_t *data, size_t size)
+{
+    for (size_t offset = 0; offset < size; offset += RX_CHUNK_SIZE)
+    {
+        while (furi_stream_buffer_bytes_available(fhttp->flipper_http_stream) > RX_BUF_SIZE - RX_CHUNK_SIZE)
+        {
+            furi_delay_ms(1);
+        }
+        serial_shim_receive(data + offset, MIN((size_t)RX_CHUNK_SIZE, size - offset));
+    }
+}
+
+// Replay the response with the given line handler; returns the allocations made while it was received
+static size_t test_run(FlipperHTTP *fhttp, FlipperHTTP_Callback line_handler, TestRx *rx, FuriString *response)
+{
+    rx->lines = 0;
+    rx->body_bytes = 0;
+    fhttp->handle_rx_line_cb = line_handler;
+    fhttp->callback_context = rx;
+    fhttp->save_received_data = true;
+    furi_event_flag_clear(fhttp->events, FlipperHTTPEvtComplete);
+
+    atomic_store(&test_allocations, 0);
+    atomic_store(&test_counting, true);
+    test_replay(fhttp, (const uint8_t *)furi_string_get_cstr(response), furi_string_size(response));
+    uint32_t flags = furi_event_flag_wait(fhttp->events, FlipperHTTPEvtComplete, FuriFlagWaitAny, TEST_TIMEOUT_MS);
+    atomic_store(&test_counting, false);
+
+    if (flags & FuriFlagError)
+    {
+        fprintf(stderr, "The response did not complete\n");
+    }
+    return atomic_load(&test_allocations);
+}
+
+int main(int argc, char **argv)
+{
+    const char *corpus = argc > 1 ? argv[1] : "corpus";
+    char path[256];
+    snprintf(path, sizeof(path), "%s/std-index.html", corpus);
+    FuriString *page = shim_load_file(path);
+    if (!page)
+    {
+        fprintf(stderr, "Cannot read %s\n", path);
+        return 1;
+    }
+
+    // [GET/SUCCESS], the page repeated up to TEST_RESPONSE_SIZE, [GET/END]
+    FuriString *response = furi_string_alloc_set_str("[GET/SUCCESS] GET request successful.\n");
+    while (furi_string_size(response) < TEST_RESPONSE_SIZE)
+    {
+        furi_string_cat(response, page);
+    }
+    furi_string_cat_str(response, "\n[GET/END]\n");
+
+    // The sink receives the body lines without their line breaks
+    size_t body_bytes = 0;
+    for (const char *c = strchr(furi_string_get_cstr(response), '\n') + 1; strncmp(c, "[GET/END]", 9) != 0; c++)
+    {
+        body_bytes += *c != '\n';
+    }
+
+    FlipperHTTP *fhttp = flipper_http_alloc();
+    furi_check(fhttp);
+    TestRx rx = {.fhttp = fhttp};
+    flipper_http_set_sink_parser(fhttp, test_sink_parse, &rx);
+    fhttp->state = IDLE;
+
+    static const struct
+    {
+        const char *name;
+        FlipperHTTP_Callback line_handler;
+    } handlers[] = {
+        {"original", test_original_line},
+        {"current", test_current_line},
+    };
+    int failures = 0;
+    printf("%-10s %8s %10s %12s %10s\n", "handler", "lines", "body bytes", "allocations", "per line");
+    for (size_t i = 0; i < COUNT_OF(handlers); i++)
+    {
+        size_t allocations = test_run(fhttp, handlers[i].line_handler, &rx, response);
+        printf("%-10s %8zu %10zu %12zu %10.2f\n",
+               handlers[i].name,
+               rx.lines,
+               rx.body_bytes,
+               allocations,
+               (double)allocations / (double)rx.lines);
+
+        SHIM_CHECK(failures, rx.body_bytes == body_bytes);
+        SHIM_CHECK(failures, fhttp->active_request == FlipperHTTPRequestNone);
+        SHIM_CHECK(failures, flipper_http_lost_bytes(fhttp) == 0);
+        if (handlers[i].line_handler == test_current_line)
+        {
+            SHIM_CHECK(failures, allocations == 0);
+        }
+        else
+        {
+            SHIM_CHECK(failures, allocations >= rx.lines);
+        }
+    }
+
+    flipper_http_free(fhttp);
+    furi_string_free(response);
+    furi_string_free(page);
+    printf(failures ? "FAILED (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
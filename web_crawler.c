@@ -43,6 +43,20 @@ void web_crawler_app_free(WebCrawlerApp *app)
         app->http_method = NULL;
     }
 
+    // Free the BROWSE parser (after the loader, whose FlipperHTTP may still feed it)
+    if (app->html_stream)
+    {
+        html_furi_stream_free(app->html_stream);
+        app->html_stream = NULL;
+    }
+
+    // Close the files of the last site crawl
+    if (app->crawl_engine)
+    {
+        crawl_engine_free(app->crawl_engine);
+        app->crawl_engine = NULL;
+    }
+
     free_all(app);
     furi_record_close(RECORD_STORAGE);
     view_dispatcher_free(app->view_dispatcher);
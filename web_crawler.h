@@ -4,6 +4,8 @@
 
 #include <easy_flipper/easy_flipper.h>
 #include <flipper_http/flipper_http.h>
+#include <html/html_furi_stream.h>
+#include <crawl/crawl_engine.h>
 #include <text_input/uart_text_input.h>
 #include "web_crawler_icons.h"
 
@@ -15,6 +17,8 @@ extern char *http_method_names[];
 typedef enum
 {
     WebCrawlerSubmenuIndexRun,     // click to go to Run the GET request
+    WebCrawlerSubmenuIndexCrawl,   // click to fetch every URL in the crawl list
+    WebCrawlerSubmenuIndexSite,    // click to crawl the links of the URL in the settings
     WebCrawlerSubmenuIndexAbout,   // click to go to About screen
     WebCrawlerSubmenuIndexConfig,  // click to go to Config submenu (Wifi, File)
     WebCrawlerSubmenuIndexRequest, // click to go to Request submenu (Set URL, HTTP Method, Headers)
@@ -104,6 +108,11 @@ typedef struct
 
     char *temp_buffer_payload;
     uint32_t temp_buffer_size_payload;
+
+    HTMLFuriStream *html_stream; // Parses BROWSE pages while they download
+
+    size_t crawl_offset;       // Byte offset of the next URL in the crawl list
+    CrawlEngine *crawl_engine; // Frontier and visited set of the site crawl
 } WebCrawlerApp;
 
 /**